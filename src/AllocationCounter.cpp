@@ -0,0 +1,60 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#include "AllocationCounter.h"
+#include <cstdlib>
+#include <new>
+
+#ifdef ENABLE_ALLOCATION_COUNTER
+
+static thread_local bool countAllocations = false;
+static thread_local Uint64 allocationCount = 0;
+
+bool AllocationCounterEnabled() {
+    return true;
+}
+
+void StartCountingAllocations() {
+    allocationCount = 0;
+    countAllocations = true;
+}
+
+Uint64 StopCountingAllocations() {
+    countAllocations = false;
+    return allocationCount;
+}
+
+
+
+
+
+void* operator new(size_t size) {
+    if (countAllocations) allocationCount++;
+    void* memory = std::malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) throw std::bad_alloc();
+    return memory;
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    std::free(memory);
+}
+
+#else
+
+// Counter disabled, the global operator new is left as the standard library's
+bool AllocationCounterEnabled() {
+    return false;
+}
+
+void StartCountingAllocations() {}
+
+Uint64 StopCountingAllocations() {
+    return 0;
+}
+
+#endif
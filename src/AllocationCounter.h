@@ -0,0 +1,19 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#ifndef CPP_PROGRAMMINGPROJECT_ALLOCATIONCOUNTER_H
+#define CPP_PROGRAMMINGPROJECT_ALLOCATIONCOUNTER_H
+
+#include "GameCore.h"
+
+/*
+ * Counts calls to the global operator new, which AllocationCounter.cpp replaces when built with
+ * ENABLE_ALLOCATION_COUNTER. Only allocations made by the thread that started counting are counted, so work on other
+ * threads (such as level generation) is not included. Without ENABLE_ALLOCATION_COUNTER nothing is counted.
+ */
+bool AllocationCounterEnabled();
+void StartCountingAllocations();
+Uint64 StopCountingAllocations();                                                                                       // returns the allocations since starting
+
+#endif //CPP_PROGRAMMINGPROJECT_ALLOCATIONCOUNTER_H
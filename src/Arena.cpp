@@ -0,0 +1,77 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#include "Arena.h"
+#include <algorithm>
+
+Arena::Arena(size_t bytes) {
+    Reset(bytes);
+}
+
+void Arena::Reset(size_t minimumBytes) {
+    /*
+     * Releases every allocation made from the block in one go, so nothing allocated from the arena may be used after
+     * this. Heap allocations made once the block ran out must already have been deallocated. The block is replaced by
+     * a larger one if minimumBytes, or the usage before the reset, did not fit.
+     */
+    size_t wanted = std::max(minimumBytes, peak);
+    if (wanted > capacity) {
+        block.reset(new char[wanted]);
+        capacity = wanted;
+    }
+    used = 0;
+    peak = 0;
+    overflowBytes = 0;
+}
+
+void* Arena::Allocate(size_t bytes, size_t alignment) {
+    size_t start = (used + alignment - 1) & ~(alignment - 1);
+    if (start + bytes > capacity) {
+        overflowBytes += bytes;
+        peak = std::max(peak, used + overflowBytes);
+        return ::operator new(bytes);                                                                                   // freed by Deallocate
+    }
+
+    used = start + bytes;
+    peak = std::max(peak, used + overflowBytes);
+    return block.get() + start;
+}
+
+void Arena::Deallocate(void* memory) {
+    // memory from the block is only released by Reset or Rewind
+    if (memory != nullptr && !Owns(memory)) ::operator delete(memory);
+}
+
+bool Arena::Owns(const void* memory) const {
+    const char* address = static_cast<const char*>(memory);
+    return block && address >= block.get() && address < block.get() + capacity;
+}
+
+
+
+
+
+size_t Arena::Mark() const {
+    return used;
+}
+
+void Arena::Rewind(size_t mark) {
+    used = mark;
+}
+
+size_t Arena::GetCapacity() const {
+    return capacity;
+}
+
+size_t Arena::GetUsed() const {
+    return used;
+}
+
+size_t Arena::GetPeak() const {
+    return peak;
+}
+
+size_t Arena::GetOverflowBytes() const {
+    return overflowBytes;
+}
@@ -0,0 +1,109 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#ifndef CPP_PROGRAMMINGPROJECT_ARENA_H
+#define CPP_PROGRAMMINGPROJECT_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+/*
+ * Bump allocator for storage that shares a lifetime, such as the track and items of a level. Allocations are taken in
+ * order from a single block and are not freed individually, everything is released at once by Reset. If the block
+ * runs out, allocations fall back to the heap and are counted as overflow, and the next Reset grows the block so the
+ * same amount fits. An arena is only used by one thread at a time.
+ */
+class Arena {
+    private:
+        std::unique_ptr<char[]> block {};
+        size_t capacity = 0;
+        size_t used = 0;
+        size_t peak = 0;                                                                                                // most used since the last Reset, including overflow
+        size_t overflowBytes = 0;                                                                                       // allocated from the heap since the last Reset
+
+    public:
+        Arena() = default;
+        explicit Arena(size_t bytes);
+
+        void Reset(size_t minimumBytes = 0);
+        void* Allocate(size_t bytes, size_t alignment);
+        void Deallocate(void* memory);
+        bool Owns(const void* memory) const;
+
+        // Frames, for scratch memory that is released when the work using it is done
+        size_t Mark() const;
+        void Rewind(size_t mark);
+
+        size_t GetCapacity() const;
+        size_t GetUsed() const;
+        size_t GetPeak() const;
+        size_t GetOverflowBytes() const;
+};
+
+// Releases the scratch memory allocated from an arena during its lifetime
+class ArenaFrame {
+    private:
+        Arena& arena;
+        size_t mark;
+
+    public:
+        explicit ArenaFrame(Arena& frameArena) : arena(frameArena), mark(frameArena.Mark()) {}
+        ~ArenaFrame() {
+            arena.Rewind(mark);
+        }
+        ArenaFrame(const ArenaFrame&) = delete;
+        ArenaFrame& operator=(const ArenaFrame&) = delete;
+};
+
+
+
+
+
+/*
+ * Standard allocator that allocates from an Arena, or from the heap if it has none. The arena moves (and swaps) with
+ * the container's storage, whilst copies of a container are allocated from the heap, so a copy never outlives the
+ * arena it was copied from.
+ */
+template <typename T>
+struct ArenaAllocator {
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    Arena* arena = nullptr;
+
+    ArenaAllocator() = default;
+    explicit ArenaAllocator(Arena* allocationArena) : arena(allocationArena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(size_t count) {
+        if (arena == nullptr) return static_cast<T*>(::operator new(count * sizeof(T)));
+        return static_cast<T*>(arena->Allocate(count * sizeof(T), alignof(T)));
+    }
+    void deallocate(T* memory, size_t) {
+        if (arena == nullptr) ::operator delete(memory);
+        else arena->Deallocate(memory);
+    }
+    ArenaAllocator select_on_container_copy_construction() const {
+        return ArenaAllocator {};
+    }
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) {
+    return lhs.arena == rhs.arena;
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) {
+    return lhs.arena != rhs.arena;
+}
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+#endif //CPP_PROGRAMMINGPROJECT_ARENA_H
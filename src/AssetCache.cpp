@@ -0,0 +1,148 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#include "AssetCache.h"
+#include "Trace.h"
+#include "TextRenderer.h"
+
+AssetCache::AssetCache(SDL_Renderer* RENDERER) {
+    renderer = RENDERER;
+    stats = std::make_shared<AssetStats>();
+}
+
+
+
+
+
+TextureHandle AssetCache::GetTexture(const std::string& imgPath) {
+    /*
+     * Returns a shared handle to the texture for the image at imgPath. The image is only decoded and uploaded the first
+     * time the path is requested, after which the same texture is returned. Failed loads are also cached so a missing
+     * image is not repeatedly read from disk.
+     */
+    auto cached = textures.find(imgPath);
+    if (cached != textures.end()) {
+        stats->hits++;
+        return cached->second;
+    }
+
+    stats->misses++;
+    SDL_Surface* surface;
+    {
+        TRACE_SCOPE("IMG_Load", "assets");
+        surface = IMG_Load(imgPath.c_str());
+    }
+    if (surface == nullptr) {
+        printf("ASSETS | FAILED TO LOAD %s: %s\n", imgPath.c_str(), SDL_GetError());
+    }
+
+    TextureHandle texture = CreateTextureFromSurface(surface);
+    SDL_FreeSurface(surface);
+
+    textures[imgPath] = texture;
+    return texture;
+}
+
+FontHandle AssetCache::GetFont(const std::string& fontPath, int pointSize) {
+    // Returns a shared handle to the font at fontPath, opened once per point size
+    std::string key = fontPath + "@" + std::to_string(pointSize);
+    auto cached = fonts.find(key);
+    if (cached != fonts.end()) {
+        stats->hits++;
+        return cached->second;
+    }
+
+    stats->misses++;
+    TTF_Font* font = TTF_OpenFont(fontPath.c_str(), pointSize);
+    if (font == nullptr) {
+        printf("ASSETS | FAILED TO OPEN FONT %s: %s\n", fontPath.c_str(), TTF_GetError());
+    }
+
+    FontHandle handle (font, [](TTF_Font* f) { if (f != nullptr) TTF_CloseFont(f); });
+    fonts[key] = handle;
+    return handle;
+}
+
+AtlasHandle AssetCache::GetGlyphAtlas(const std::string& fontPath, int pointSize) {
+    // Returns a shared handle to the glyph atlas of the font at fontPath, built once per point size
+    std::string key = fontPath + "@" + std::to_string(pointSize);
+    auto cached = atlases.find(key);
+    if (cached != atlases.end()) {
+        stats->hits++;
+        return cached->second;
+    }
+
+    stats->misses++;
+    AtlasHandle atlas = std::make_shared<GlyphAtlas>(*this, GetFont(fontPath, pointSize).get());
+    atlases[key] = atlas;
+    return atlas;
+}
+
+TextureHandle AssetCache::AdoptTexture(SDL_Texture* texture) {
+    /*
+     * Wraps a texture that was not loaded from a file (such as rendered text) in a handle, so that it is destroyed
+     * once no longer used and is counted within the resident texture stats. The texture is not cached.
+     */
+    if (texture == nullptr) return {};
+
+    int w = 0, h = 0;
+    Uint32 format = 0;
+    SDL_QueryTexture(texture, &format, nullptr, &w, &h);
+    long long bytes = (long long)w * h * std::max(1, int(SDL_BYTESPERPIXEL(format)));
+
+    stats->residentTextures++;
+    stats->residentBytes += bytes;
+
+    std::shared_ptr<AssetStats> textureStats = stats;
+    return TextureHandle(texture, [textureStats, bytes](SDL_Texture* t) {
+        SDL_DestroyTexture(t);
+        textureStats->residentTextures--;
+        textureStats->residentBytes -= bytes;
+    });
+}
+
+TextureHandle AssetCache::CreateTextureFromSurface(SDL_Surface* surface) {
+    if (surface == nullptr) return {};
+    return AdoptTexture(SDL_CreateTextureFromSurface(renderer, surface));
+}
+
+TextureHandle AssetCache::CreateRenderTarget(int w, int h) {
+    // Creates a transparent texture that can be drawn onto, empty if render targets are not supported
+    if (!SDL_RenderTargetSupported(renderer)) return {};
+
+    SDL_Texture* texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+    if (texture != nullptr) SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    return AdoptTexture(texture);
+}
+
+
+
+
+
+void AssetCache::Clear() {
+    /*
+     * Drops the cache's references to all textures and fonts. Any asset that is not still held elsewhere is destroyed
+     * immediately, so this should be called before the renderer is destroyed and SDL/TTF are quit.
+     */
+    atlases.clear();
+    textures.clear();
+    fonts.clear();
+}
+
+
+
+
+
+SDL_Renderer* AssetCache::GetRenderer() const {
+    return renderer;
+}
+
+const AssetStats& AssetCache::GetStats() const {
+    return *stats;
+}
+
+void AssetCache::PrintStats() const {
+    printf("ASSETS | hits: %llu, misses: %llu, textures: %d, resident: %.2f MB\n",
+           stats->hits, stats->misses, stats->residentTextures, double(stats->residentBytes) / (1024.0 * 1024.0));
+}
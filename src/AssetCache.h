@@ -0,0 +1,63 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#ifndef CPP_PROGRAMMINGPROJECT_ASSETCACHE_H
+#define CPP_PROGRAMMINGPROJECT_ASSETCACHE_H
+
+#include "GameCore.h"
+#include <memory>
+#include <unordered_map>
+
+// Shared handles to textures and fonts, destroyed when the last handle is released
+typedef std::shared_ptr<SDL_Texture> TextureHandle;
+typedef std::shared_ptr<TTF_Font> FontHandle;
+
+class GlyphAtlas;
+typedef std::shared_ptr<GlyphAtlas> AtlasHandle;
+
+struct AssetStats {
+    unsigned long long hits = 0;                                                                                        // requests served from the cache
+    unsigned long long misses = 0;                                                                                      // requests that had to load from disk
+    int residentTextures = 0;                                                                                           // textures currently alive (cached or adopted)
+    long long residentBytes = 0;                                                                                        // approximate texture memory of those textures
+};
+
+
+
+
+
+class AssetCache {
+    private:
+        SDL_Renderer* renderer;
+
+        // cached assets, keyed by path (and point size for fonts)
+        std::unordered_map<std::string, TextureHandle> textures {};
+        std::unordered_map<std::string, FontHandle> fonts {};
+        std::unordered_map<std::string, AtlasHandle> atlases {};
+
+        // shared with texture deleters, so textures released after the cache still update the stats
+        std::shared_ptr<AssetStats> stats;
+
+    public:
+        explicit AssetCache(SDL_Renderer* RENDERER);
+
+        // Loading
+        TextureHandle GetTexture(const std::string& imgPath);
+        FontHandle GetFont(const std::string& fontPath, int pointSize);
+        AtlasHandle GetGlyphAtlas(const std::string& fontPath, int pointSize);
+        TextureHandle AdoptTexture(SDL_Texture* texture);
+        TextureHandle CreateTextureFromSurface(SDL_Surface* surface);
+        TextureHandle CreateRenderTarget(int w, int h);
+
+        // Release
+        void Clear();
+
+        // Getters
+        SDL_Renderer* GetRenderer() const;
+        const AssetStats& GetStats() const;
+        void PrintStats() const;
+};
+
+
+#endif //CPP_PROGRAMMINGPROJECT_ASSETCACHE_H
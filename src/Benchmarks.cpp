@@ -0,0 +1,1043 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#include "Benchmarks.h"
+#include "GameSession.h"
+#include "GameDisplay.h"
+#include "Replay.h"
+#include "Log.h"
+#include "AllocationCounter.h"
+#include "Renderer.h"
+#include "SpriteBatch.h"
+#include "TextRenderer.h"
+#include "FramePacer.h"
+#include <thread>
+#include <bitset>
+
+// Game constants matching a GameSession on a 1080p display
+static const int BENCH_TILE_SIZE = 48;
+static const int BENCH_MIN_TRACK_HEIGHT = 1078 - int(2.5 * BENCH_TILE_SIZE);
+static const int BENCH_MAX_TRACK_HEIGHT = BENCH_MIN_TRACK_HEIGHT - (10 * BENCH_TILE_SIZE);
+
+static double MsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+static double BenchSpeed(int difficulty) {
+    return (BENCH_TILE_SIZE/240.0) * (1 + difficulty*0.1);
+}
+
+static Track CreateBenchTrack(int difficulty, int trackLength) {
+    // Construct a track with the same jump calc vars as a GameSession would use for the difficulty
+    int jumpHeight = 6 * BENCH_TILE_SIZE;
+    double gravity = jumpHeight / (2*std::pow(1500/4.0, 2));
+    double speed = BenchSpeed(difficulty);
+
+    Track track {BENCH_MIN_TRACK_HEIGHT, BENCH_MAX_TRACK_HEIGHT, BENCH_TILE_SIZE, BENCH_TILE_SIZE};
+    track.SetPlayerJumpCalcVars(jumpHeight, gravity, speed);
+    track.SetGenerationSeed(1, 0);
+    track.ConstructTrack(difficulty, trackLength);
+    return track;
+}
+
+
+
+
+
+static void CaptureBenchView(const Track& track, const Camera& camera, TrackView& view) {
+    // Captures the track around a camera that did not move in the last step, as GameSession::CaptureViews does
+    track.CaptureView(view, TrackDisplay::GetViewRange(camera.x, camera.x, camera.width, BENCH_TILE_SIZE));
+}
+
+static int BenchTrackLookup() {
+    /*
+     * Measures Track::GetTrackAtIndex / IsObstacleAtIndex and level setup (coin and special placement, which look up
+     * every tile) as the length of the track grows. Lookup cost per call should remain flat.
+     */
+    const int lookups = 10000000;
+    const int lengths[] = {150, 1500, 15000, 150000};
+    std::vector<std::string> results {};
+
+    for (int length : lengths) {
+        Track track = CreateBenchTrack(2, length);
+        int endIndex = track.GetTrackStartEndIndex().last;
+
+        // level setup
+        auto start = std::chrono::steady_clock::now();
+        ScoreCollectables collectables {};
+        collectables.ConstructCoins(track);
+        collectables.ConstructSpecials(track);
+        double setupMs = MsSince(start);
+
+        // random lookups across the whole track
+        start = std::chrono::steady_clock::now();
+        double checksum = 0;
+        unsigned int index = 12345;
+        for (int i = 0; i < lookups; i++) {
+            index = index * 1664525u + 1013904223u;                                                                     // cheap LCG so the rng isn't measured
+            int ti = int(index % unsigned(endIndex));
+            checksum += track.GetTrackAtIndex(ti).gamey;
+            if (track.IsObstacleAtIndex(ti)) checksum += 1;
+        }
+        double lookupNs = MsSince(start) * 1.0e6 / lookups;
+
+        char line[160];
+        snprintf(line, sizeof(line), "LOOKUP BENCH | endOfTrackIndex: %7d | setup: %9.3f ms | lookup: %6.2f ns | (%.0f)",
+                 endIndex, setupMs, lookupNs, checksum);
+        results.emplace_back(line);
+    }
+
+    for (const std::string& result : results) printf("%s\n", result.c_str());
+    return 0;
+}
+
+
+
+
+
+static int BenchCulling() {
+    /*
+     * Displays frames spread across the whole level for tracks of increasing length, reporting the number of draws and
+     * the cpu time of capturing the views of the track and items and displaying them per frame. Draws go to a
+     * NullRenderer, so only the cost of deciding what to draw is measured. Neither should depend on the length of the
+     * track.
+     */
+    const int frames = 2000;
+    const int viewWidth = 1386, viewHeight = 1078;
+    const int lengths[] = {150, 1500, 15000, 150000};
+    std::vector<std::string> results {};
+
+    for (int length : lengths) {
+        Track track = CreateBenchTrack(2, length);
+        ScoreCollectables collectables {};
+        collectables.ConstructCoins(track);
+        collectables.ConstructSpecials(track);
+
+        double levelTime = track.GetTrackStartEndIndex().last * BENCH_TILE_SIZE / BenchSpeed(2);
+        NullRenderer renderer;
+        TrackDisplay trackDisplay;
+        ItemsDisplay itemsDisplay;
+        TrackView trackView;
+        ItemsView itemsView;
+        long long draws = 0;
+        double displayMs = 0;
+
+        for (int f = 0; f < frames; f++) {
+            Camera camera {levelTime * f / frames * BenchSpeed(2), viewWidth, viewHeight};
+
+            auto start = std::chrono::steady_clock::now();
+            CaptureBenchView(track, camera, trackView);
+            collectables.CaptureView(itemsView, camera.x, camera.x + camera.width);
+            trackDisplay.DisplayTrack(renderer, trackView, camera);
+            itemsDisplay.DisplayItems(renderer, itemsView, camera);
+            displayMs += MsSince(start);
+
+            draws += trackDisplay.GetDrawCount() + itemsDisplay.GetDrawCount();
+        }
+
+        char line[160];
+        snprintf(line, sizeof(line), "CULLING BENCH | endOfTrackIndex: %7d | draws/frame: %6.1f | display: %8.4f ms",
+                 track.GetTrackStartEndIndex().last, double(draws) / frames, displayMs / frames);
+        results.emplace_back(line);
+    }
+
+    for (const std::string& result : results) printf("%s\n", result.c_str());
+    return 0;
+}
+
+
+
+
+
+static int BenchCollision() {
+    /*
+     * Measures the per tick cost of the collision checks done by GameSession::Step (coin and collectable pickups, and
+     * obstacle collision) as the length of the track grows. A player sweeps along the full track at coin height, so
+     * pickups are made. The cost per tick should remain flat.
+     */
+    const int ticks = 1000000;
+    const int lengths[] = {150, 1500, 15000, 150000};
+    std::vector<std::string> results {};
+
+    for (int length : lengths) {
+        Track track = CreateBenchTrack(2, length);
+        ScoreCollectables collectables {};
+        collectables.ConstructCoins(track);
+        collectables.ConstructSpecials(track);
+
+        double trackWidth = track.GetTrackStartEndIndex().last * double(BENCH_TILE_SIZE);
+        ObjectStruct player {};
+        int collisions = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (int t = 0; t < ticks; t++) {
+            double playerx = trackWidth * t / ticks;
+            double playery = track.GetTrackAtIndex(int(playerx / BENCH_TILE_SIZE)).gamey - 2.5 * BENCH_TILE_SIZE;
+            player.Construct(playerx, playery, BENCH_TILE_SIZE, BENCH_TILE_SIZE);
+
+            collectables.UpdateCoins(player);
+            collectables.UpdateSpecials(player);
+            if (track.CheckForCollision(player)) collisions++;
+        }
+        double totalMs = MsSince(start);
+
+        char line[160];
+        snprintf(line, sizeof(line), "COLLISION BENCH | endOfTrackIndex: %7d | per tick: %7.1f ns | score: %8d | "
+                 "collisions: %d", track.GetTrackStartEndIndex().last, totalMs * 1e6 / ticks, collectables.GetScore(),
+                 collisions);
+        results.emplace_back(line);
+    }
+
+    for (const std::string& result : results) printf("%s\n", result.c_str());
+    return 0;
+}
+
+
+
+
+
+static int BenchOverlapKernel() {
+    /*
+     * Compares testing the player against every object through TrackObject::PlayerCollision, with the scalar and SIMD
+     * overlap kernels over the same objects stored in AABBArrays. Objects are coins packed closely along the track at
+     * random heights, and the player is placed at random positions over them. Returns 1 if the hit counts differ.
+     */
+    const int counts[] = {10000, 100000};
+    const long long testsPerRun = 20000000;
+    std::vector<std::string> results {};
+    bool match = true;
+
+    for (int count : counts) {
+        std::srand(1);
+        std::vector<Coin> coins {};
+        for (int i = 0; i < count; i++) {
+            coins.emplace_back(i * 12.0, std::rand() % 480, 38, 48);
+        }
+        AABBArrays bounds {};
+        bounds.Assign(coins);
+
+        int queries = int(testsPerRun / count);
+        std::vector<ObjectStruct> players (queries);
+        for (ObjectStruct &player : players) {
+            player.Construct(std::rand() % (count * 12), std::rand() % 480, BENCH_TILE_SIZE, BENCH_TILE_SIZE);
+        }
+
+        // current path, a PlayerCollision call per object
+        long long objectHits = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (const ObjectStruct &player : players) {
+            for (const Coin &coin : coins) {
+                if (coin.PlayerCollision(player)) objectHits++;
+            }
+        }
+        double objectMs = MsSince(start);
+
+        // kernels, 8 objects per call
+        long long scalarHits = 0, simdHits = 0;
+        start = std::chrono::steady_clock::now();
+        for (const ObjectStruct &player : players) {
+            for (size_t first = 0; first < bounds.count; first += AABBArrays::LANES) {
+                scalarHits += std::bitset<AABBArrays::LANES>(OverlapMaskScalar(bounds, first, player)).count();
+            }
+        }
+        double scalarMs = MsSince(start);
+
+        start = std::chrono::steady_clock::now();
+        for (const ObjectStruct &player : players) {
+            for (size_t first = 0; first < bounds.count; first += AABBArrays::LANES) {
+                simdHits += std::bitset<AABBArrays::LANES>(OverlapMask(bounds, first, player)).count();
+            }
+        }
+        double simdMs = MsSince(start);
+
+        match = match && objectHits == scalarHits && objectHits == simdHits;
+        double tests = double(queries) * count;
+        char line[200];
+        snprintf(line, sizeof(line), "OVERLAP BENCH | objects: %6d | PlayerCollision: %6.2f ns | scalar: %6.2f ns | "
+                 "%s: %6.2f ns | hits: %lld %lld %lld", count, objectMs * 1e6 / tests, scalarMs * 1e6 / tests,
+                 OverlapKernelName(), simdMs * 1e6 / tests, objectHits, scalarHits, simdHits);
+        results.emplace_back(line);
+    }
+
+    for (const std::string& result : results) printf("%s\n", result.c_str());
+    return match ? 0 : 1;
+}
+
+
+
+
+
+static int BenchLevelTransition() {
+    /*
+     * Times the level transition of a GameSession for each difficulty, with the next level generated synchronously on
+     * the transition (as before) and in the background. In the background case the level is given time to finish
+     * generating, as it would whilst the previous level is being played. Texture creation is not included.
+     */
+    std::vector<std::string> results {};
+
+    for (int async = 0; async <= 1; async++) {
+        GameSession session {1386, 1078, 1, async == 1};
+        double totalMs = 0, worstMs = 0;
+
+        for (int difficulty = 1; difficulty <= 6; difficulty++) {
+            while (!session.NextLevelReady()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+            auto start = std::chrono::steady_clock::now();
+            session.NextLevel();
+            double transitionMs = MsSince(start);
+
+            totalMs += transitionMs;
+            worstMs = std::max(worstMs, transitionMs);
+        }
+
+        char line[160];
+        snprintf(line, sizeof(line), "TRANSITION BENCH | %-10s | avg: %8.4f ms | worst: %8.4f ms",
+                 async ? "background" : "sync", totalMs / 6, worstMs);
+        results.emplace_back(line);
+    }
+
+    for (const std::string& result : results) printf("%s\n", result.c_str());
+    return 0;
+}
+
+
+
+
+
+static int BenchEndless() {
+    /*
+     * Streams 1,000,000 tiles of endless track (and coins) by moving the camera along it, as a GameSession in endless
+     * mode would. After the rings have been filled, the memory held by the track and the number of coins should no
+     * longer grow. Every resident tile is also checked to resolve to its own segment, or a gap. Returns 1 on failure.
+     */
+    const int totalTiles = 1000000;
+    const int viewWidth = 1386, viewHeight = 1078;
+
+    Track track {BENCH_MIN_TRACK_HEIGHT, BENCH_MAX_TRACK_HEIGHT, BENCH_TILE_SIZE, BENCH_TILE_SIZE};
+    track.SetPlayerJumpCalcVars(6 * BENCH_TILE_SIZE, 6 * BENCH_TILE_SIZE / (2*std::pow(1500/4.0, 2)), BenchSpeed(0));
+    track.SetGenerationSeed(1, 0);
+    track.StartEndless(0);
+    ScoreCollectables collectables {};
+
+    size_t warmBytes = 0, maxBytes = 0;
+    size_t warmCoins = 0, maxCoins = 0;
+    int badTiles = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (double camerax = 0; track.GetResidentRange().last < totalTiles; camerax += viewWidth / 2.0) {
+        Camera camera {camerax, viewWidth, viewHeight};
+        TileRange added = track.StreamAhead(camera);
+        if (added.first <= added.last) collectables.StreamCoins(track, added);
+
+        // check the resident tiles resolve to themselves, unless they are gaps
+        TileRange resident = track.GetResidentRange();
+        for (int ti = resident.first; ti <= resident.last; ti += 7) {
+            if (!track.IsGapAtIndex(ti) && track.GetTrackAtIndex(ti).trackIndex != ti) badTiles++;
+        }
+
+        // record memory use once the rings are full
+        if (resident.last - resident.first + 1 < Track::CHUNK_TILES * Track::RING_CHUNKS) continue;
+        if (warmBytes == 0) {
+            warmBytes = track.GetResidentBytes();
+            warmCoins = collectables.GetCoinCapacity();
+        }
+        maxBytes = std::max(maxBytes, track.GetResidentBytes());
+        maxCoins = std::max(maxCoins, collectables.GetCoinCapacity());
+    }
+    double streamMs = MsSince(start);
+
+    bool constantMemory = (maxBytes == warmBytes) && (maxCoins == warmCoins);
+    printf("ENDLESS BENCH | tiles: %d | time: %.1f ms | track bytes warm: %zu, max: %zu | coin capacity warm: %zu, "
+           "max: %zu | bad tiles: %d | %s\n", track.GetResidentRange().last, streamMs, warmBytes, maxBytes,
+           warmCoins, maxCoins, badTiles, (constantMemory && badTiles == 0) ? "PASS" : "FAIL");
+
+    return (constantMemory && badTiles == 0) ? 0 : 1;
+}
+
+
+
+
+
+static uint64_t HashLevel(const LevelData& level) {
+    // FNV-1a hash of the position of every tile of the track, and whether it holds an obstacle
+    uint64_t hash = 14695981039346656037ull;
+    auto add = [&hash](int64_t value) {
+        for (int b = 0; b < 8; b++) {
+            hash ^= uint64_t(value >> (b * 8)) & 0xFF;
+            hash *= 1099511628211ull;
+        }
+    };
+
+    for (int ti = 0; ti < level.track.GetTrackStartEndIndex().last; ti++) {
+        const TrackSegment &segment = level.track.GetTrackAtIndex(ti);
+        add(segment.trackIndex);
+        add(int64_t(segment.gamex));
+        add(int64_t(segment.gamey));
+        add(level.track.IsObstacleAtIndex(ti));
+    }
+    return hash;
+}
+
+static int BenchRandom() {
+    /*
+     * Compares the cost of a RandomStream draw with std::rand, then checks that generation is reproducible: the levels
+     * of two seeds are generated on the main thread, and again all at once on worker threads in reverse order. The
+     * tracks must be identical. Returns 1 if any level differs.
+     */
+    const int draws = 50000000;
+
+    // throughput, the sums are printed so the draws are not optimised away
+    auto start = std::chrono::steady_clock::now();
+    long long randSum = 0;
+    for (int i = 0; i < draws; i++) randSum += std::rand() % 100;
+    double randMs = MsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    RandomStream stream {1, 0, RANDOM_LAYOUT, 0};
+    long long streamSum = 0;
+    for (int i = 0; i < draws; i++) streamSum += stream.Below(100);
+    double streamMs = MsSince(start);
+
+    printf("RANDOM BENCH | std::rand: %.2f ns/draw (sum %lld) | RandomStream: %.2f ns/draw (sum %lld)\n",
+           randMs * 1e6 / draws, randSum, streamMs * 1e6 / draws, streamSum);
+
+    // reproducibility, levels are generated as a GameSession would for each difficulty in turn
+    LevelSettings settings {BENCH_MIN_TRACK_HEIGHT, BENCH_MAX_TRACK_HEIGHT, BENCH_TILE_SIZE, BENCH_TILE_SIZE,
+                            6 * BENCH_TILE_SIZE, 6 * BENCH_TILE_SIZE / (2*std::pow(1500/4.0, 2)), 0};
+    const unsigned int seeds[] = {1, 1712404869};
+    const int levels = GenerationProfiles::MAX_DIFFICULTY + 1;
+    int mismatches = 0;
+
+    for (unsigned int seed : seeds) {
+        settings.seed = seed;
+        std::vector<uint64_t> serial {};
+        for (int level = 0; level < levels; level++) {
+            serial.push_back(HashLevel(GameSession::GenerateLevel(settings, level, level)));
+        }
+
+        std::vector<std::future<LevelData>> workers {};
+        for (int level = levels - 1; level >= 0; level--) {
+            workers.push_back(std::async(std::launch::async, [settings, level]() {
+                return GameSession::GenerateLevel(settings, level, level);
+            }));
+        }
+        for (int level = levels - 1; level >= 0; level--) {
+            if (HashLevel(workers[levels - 1 - level].get()) != serial[level]) mismatches++;
+        }
+        printf("RANDOM BENCH | seed %u | level 0 hash: %016llx\n", seed, (unsigned long long)serial[0]);
+    }
+
+    printf("RANDOM BENCH | levels compared: %d | mismatches: %d | %s\n", levels * 2, mismatches,
+           mismatches == 0 ? "PASS" : "FAIL");
+    return mismatches == 0 ? 0 : 1;
+}
+
+
+
+
+
+static int BenchReplay() {
+    /*
+     * Records sessions played by a bot (jumping on a cycle, and pausing now and then) until game-over, then plays each
+     * replay back without a window. The playback must end on the same tick with the same score and the same levels.
+     * Reports the size of the replays and the playback speed. Returns 1 if any playback desyncs.
+     */
+    const std::string path = "BenchReplay.rpl";
+    const int windowWidth = 1386, windowHeight = 1078;
+    const int sessions = 10;
+    int desyncs = 0;
+
+    for (int endless = 0; endless <= 1; endless++) {
+        Uint64 totalTicks = 0, totalBytes = 0;
+        double recordMs = 0, replayMs = 0;
+        int maxDifficulty = 0;
+        std::vector<Uint64> sessionTicks {};
+
+        for (unsigned int seed = 1; seed <= sessions; seed++) {
+            ReplayWriter recorder;
+            std::string error;
+            if (!recorder.Open(path, {seed, windowWidth, windowHeight, endless == 1}, error)) {
+                printf("REPLAY BENCH | ERROR: %s\n", error.c_str());
+                return 1;
+            }
+
+            auto start = std::chrono::steady_clock::now();
+            GameSession session {windowWidth, windowHeight, seed, true, endless == 1};
+            Uint64 tick = 0;
+            for (; !session.GameOver(); tick++) {
+                SessionInputs inputs;
+                inputs.jumpHeld = (tick % 900) < 350 + (tick / 900) % 7 * 20;                                           // vary the hold so jumps differ
+                inputs.pausePressed = (tick % 60000) >= 30000 && (tick % 60000) < 30040;
+                inputs.resumePressed = (tick % 60000) >= 32000 && (tick % 60000) < 32040;
+
+                recorder.RecordInputs(tick, inputs);
+                session.Step(inputs);
+                recorder.RecordDifficulty(tick, session.GetDifficulty());
+            }
+            recorder.Finish(tick, session.GetCollectables().GetScore());
+            recordMs += MsSince(start);
+            totalTicks += tick;
+            sessionTicks.push_back(tick);
+            totalBytes += recorder.GetBytesWritten();
+            maxDifficulty = std::max(maxDifficulty, session.GetDifficulty());
+
+            ReplayReader replay;
+            if (!replay.Open(path, error)) {
+                printf("REPLAY BENCH | ERROR: %s\n", error.c_str());
+                return 1;
+            }
+            ReplayResult result = PlayReplayHeadless(replay);
+            replayMs += result.seconds * 1000;
+            if (result.desynced) {
+                printf("REPLAY BENCH | seed %u DESYNC: %s\n", seed, result.reason.c_str());
+                desyncs++;
+            }
+        }
+
+        // the last replay played with the seed of a session that ended differently must be detected as a desync
+        auto otherSession = std::find_if(sessionTicks.begin(), sessionTicks.end(), [&sessionTicks](Uint64 ticks) {
+            return ticks != sessionTicks.back();
+        });
+        if (otherSession != sessionTicks.end()) {
+            {
+                std::fstream replayFile(path, std::ios::in | std::ios::out | std::ios::binary);
+                replayFile.seekp(5);                                                                                    // seed follows the magic and version
+                replayFile.put(char(otherSession - sessionTicks.begin() + 1));                                          // seeds below 128 are 1 byte
+            }
+            ReplayReader tampered;
+            std::string error;
+            if (!tampered.Open(path, error) || !PlayReplayHeadless(tampered).desynced) {
+                printf("REPLAY BENCH | replay with a changed seed was not detected\n");
+                desyncs++;
+            }
+        }
+        std::remove(path.c_str());
+
+        printf("REPLAY BENCH | %-7s | sessions: %d, ticks: %llu, max difficulty: %d | replays: %llu bytes (%.1f bytes/min) "
+               "| record: %.0f ms, replay: %.0f ms (%.0fx real time)\n",
+               endless ? "endless" : "levels", sessions, (unsigned long long)totalTicks, maxDifficulty,
+               (unsigned long long)totalBytes, totalBytes * 60000.0 / double(totalTicks), recordMs, replayMs,
+               double(totalTicks) / replayMs);
+    }
+
+    printf("REPLAY BENCH | reader memory: %zu bytes | desyncs: %d | %s\n", sizeof(ReplayReader), desyncs,
+           desyncs == 0 ? "PASS" : "FAIL");
+    return desyncs == 0 ? 0 : 1;
+}
+
+
+
+
+
+static int BenchLog() {
+    /*
+     * Compares the time taken on the calling thread by printf and by a LOG_INFO call, for bursts of messages like those
+     * printed during level generation, with a worker thread logging at the same time. Then logs more messages at once
+     * than a ring holds, which must be dropped and counted rather than block. Returns 1 if no messages were dropped.
+     */
+    const int bursts = 8;
+    const int burstMessages = 200;
+
+    // printf, the baseline
+    double printfMaxNs = 0, printfTotalNs = 0;
+    for (int m = 0; m < burstMessages; m++) {
+        auto start = std::chrono::steady_clock::now();
+        printf("LOG BENCH | printf %d, x: %f\n", m, m * 48.0);
+        double ns = MsSince(start) * 1e6;
+        printfTotalNs += ns;
+        printfMaxNs = std::max(printfMaxNs, ns);
+    }
+    fflush(stdout);
+
+    // logger, whilst another thread logs into its own ring
+    std::thread worker([]() {
+        for (int m = 0; m < bursts * burstMessages / 2; m++) {
+            LOG_INFO("LOG BENCH | worker %d", m);
+            if (m % 50 == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    LOG_INFO("LOG BENCH | started");                                                                                    // the first call creates the ring
+    double logMaxNs = 0, logTotalNs = 0;
+    for (int b = 0; b < bursts; b++) {
+        for (int m = 0; m < burstMessages; m++) {
+            auto start = std::chrono::steady_clock::now();
+            LOG_INFO("LOG BENCH | burst %d message %d, x: %f", b, m, m * 48.0);
+            double ns = MsSince(start) * 1e6;
+            logTotalNs += ns;
+            logMaxNs = std::max(logMaxNs, ns);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));                                                      // a level's worth of frames
+    }
+    worker.join();
+    Logger::Get().Flush();
+    Uint64 droppedInBursts = Logger::Get().GetDroppedCount();
+
+    // overflow, more than a ring can hold at once
+    const int overflowMessages = int(Logger::RING_MESSAGES) * 2;
+    auto start = std::chrono::steady_clock::now();
+    for (int m = 0; m < overflowMessages; m++) LOG_INFO("LOG BENCH | overflow %d", m);
+    double overflowMs = MsSince(start);
+    Logger::Get().Flush();
+    Uint64 droppedInOverflow = Logger::Get().GetDroppedCount() - droppedInBursts;
+
+    printf("LOG BENCH | printf: avg %.0f ns, max %.0f ns | LOG_INFO: avg %.0f ns, max %.0f ns | dropped: %llu\n",
+           printfTotalNs / burstMessages, printfMaxNs, logTotalNs / (bursts * burstMessages), logMaxNs,
+           (unsigned long long)droppedInBursts);
+    printf("LOG BENCH | overflow of %d messages: %.3f ms, dropped: %llu | %s\n", overflowMessages, overflowMs,
+           (unsigned long long)droppedInOverflow, droppedInOverflow > 0 ? "PASS" : "FAIL");
+    return droppedInOverflow > 0 ? 0 : 1;
+}
+
+
+
+
+
+static int BenchAllocations() {
+    /*
+     * Counts the heap allocations made by the game thread over 10,000 ticks of a session, played by a bot that jumps on
+     * a cycle and pauses once, in level and endless mode. In level mode the session is also moved onto the next level
+     * every 2,000 ticks, once that level has been generated. Generation on a worker thread is not counted. The ticks
+     * that change level swap the new level in and start the next generation, so their allocations are counted and
+     * reported separately. Returns 1 if any other tick allocated anything, or if no level changes were made, or if the
+     * build cannot count allocations.
+     */
+    if (!AllocationCounterEnabled()) {
+        printf("ALLOCATION BENCH | FAIL | build with ENABLE_ALLOCATION_COUNTER to count allocations\n");
+        return 1;
+    }
+    const int windowWidth = 1386, windowHeight = 1078;
+    const Uint64 ticks = 10000, transitionTicks = 2000;
+    int failures = 0;
+
+    for (int endless = 0; endless <= 1; endless++) {
+        GameSession session {windowWidth, windowHeight, 1, true, endless == 1};
+        session.ConsumeLevelChanged();                                                                                  // the first level, made outside the ticks
+        Uint64 allocations = 0, counted = 0;
+        Uint64 changeAllocations = 0, changes = 0;
+        auto start = std::chrono::steady_clock::now();
+
+        for (Uint64 tick = 0; tick < ticks && !session.GameOver(); tick++) {
+            SessionInputs inputs;
+            inputs.jumpHeld = (tick % 900) < 350;
+            inputs.pausePressed = tick == 5000;
+            inputs.resumePressed = tick == 5100;
+
+            bool transition = !endless && tick % transitionTicks == transitionTicks - 1;
+            while (transition && !session.NextLevelReady()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+            StartCountingAllocations();
+            if (transition) session.NextLevel();
+            session.Step(inputs);
+            Uint64 stepAllocations = StopCountingAllocations();
+
+            if (session.ConsumeLevelChanged()) {
+                changeAllocations += stepAllocations;
+                changes++;
+                continue;
+            }
+            allocations += stepAllocations;
+            counted++;
+        }
+
+        printf("ALLOCATION BENCH | %-7s | ticks: %llu, difficulty: %d, time: %.3f ms | allocations: %llu | "
+               "level changes: %llu, allocations: %llu\n", endless ? "endless" : "levels", (unsigned long long)counted,
+               session.GetDifficulty(), MsSince(start), (unsigned long long)allocations, (unsigned long long)changes,
+               (unsigned long long)changeAllocations);
+        if (allocations != 0 || counted < ticks / 2) failures++;
+        if (!endless && changes == 0) failures++;
+    }
+
+    printf("ALLOCATION BENCH | %s\n", failures == 0 ? "PASS" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}
+
+
+
+
+
+static int BenchArena() {
+    /*
+     * Generates levels of each difficulty for a number of seeds, reusing one arena as a session does, and reports the
+     * peak arena usage of each difficulty against the size of the arena, along with the heap allocations and time taken
+     * by each generation. Returns 1 if any level did not fit in its arena.
+     */
+    LevelSettings settings {BENCH_MIN_TRACK_HEIGHT, BENCH_MAX_TRACK_HEIGHT, BENCH_TILE_SIZE, BENCH_TILE_SIZE,
+                            6 * BENCH_TILE_SIZE, 6 * BENCH_TILE_SIZE / (2*std::pow(1500/4.0, 2)), 0};
+    const unsigned int seeds = 50;
+    std::unique_ptr<Arena> arena (new Arena);
+    Uint64 totalOverflow = 0;
+
+    GameSession::GenerateLevel(settings, 0, 0);                                                                         // load the generation profiles first
+    for (int difficulty = 0; difficulty <= GenerationProfiles::MAX_DIFFICULTY; difficulty++) {
+        size_t peak = 0, capacity = 0, overflow = 0;
+        Uint64 allocations = 0;
+        double generateMs = 0;
+
+        for (unsigned int seed = 1; seed <= seeds; seed++) {
+            settings.seed = seed;
+            auto start = std::chrono::steady_clock::now();
+            StartCountingAllocations();
+            LevelData level = GameSession::GenerateLevel(settings, difficulty, difficulty, std::move(arena));
+            allocations += StopCountingAllocations();
+            generateMs += MsSince(start);
+
+            peak = std::max(peak, level.arena->GetPeak());
+            capacity = std::max(capacity, level.arena->GetCapacity());
+            overflow += level.arena->GetOverflowBytes();
+            arena = std::move(level.arena);                                                                             // reset by the next generation, once level is gone
+        }
+
+        char allocationText[32] = "not counted";
+        if (AllocationCounterEnabled()) {
+            snprintf(allocationText, sizeof(allocationText), "%.1f", double(allocations) / seeds);
+        }
+        printf("ARENA BENCH | difficulty %d | arena: %6.1f KB, peak used: %6.1f KB, overflowed: %zu bytes | "
+               "heap allocations per level: %s | generation: %.3f ms\n", difficulty, capacity / 1024.0,
+               peak / 1024.0, overflow, allocationText, generateMs / seeds);
+        totalOverflow += overflow;
+    }
+
+    printf("ARENA BENCH | %s\n", totalOverflow == 0 ? "PASS" : "FAIL");
+    return totalOverflow == 0 ? 0 : 1;
+}
+
+
+
+
+
+// Software renderer drawing to a surface, so textures can be created and drawn without a window or GPU
+struct BenchSoftwareRenderer {
+    SDL_Surface* surface = nullptr;
+    SDL_Renderer* renderer = nullptr;
+
+    BenchSoftwareRenderer(int width, int height) {
+        TTF_Init();
+        surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+        if (surface) renderer = SDL_CreateSoftwareRenderer(surface);
+    }
+    ~BenchSoftwareRenderer() {
+        if (renderer) SDL_DestroyRenderer(renderer);
+        SDL_FreeSurface(surface);
+        TTF_Quit();
+    }
+};
+
+static int BenchRender() {
+    /*
+     * Plays a session at 60 frames per second, displaying each frame as the game loop does into a RecordingRenderer,
+     * and reports the draw calls, sprites, texture switches and pixels covered per frame by each part of the display.
+     * Textures are created by a software renderer drawing to a surface, so no window or GPU is needed. The cpu time per
+     * frame is reported for displaying to a NullRenderer, for recording, and for playing the recording back to the
+     * software renderer.
+     */
+    const int windowWidth = 1386, windowHeight = 1078;
+    const int frames = 3000;
+    const Uint64 ticksPerFrame = 16;
+    const char* partNames[] = {"background", "track", "player", "items", "hud"};
+    const int parts = 5;
+
+    BenchSoftwareRenderer softwareRenderer {windowWidth, windowHeight};
+    if (softwareRenderer.renderer == nullptr) {
+        printf("RENDER BENCH | ERROR: could not create a software renderer: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    RecordingRenderer recorder {windowWidth, windowHeight};
+    NullRenderer nullRenderer;
+    SDLRenderer software {softwareRenderer.renderer};
+    RenderStats partStats[parts] {};
+    double nullMs = 0, recordMs = 0, playbackMs = 0;
+    unsigned int seed = 1;
+    int sessions = 1;
+
+    {
+        AssetCache assets(softwareRenderer.renderer);
+        std::unique_ptr<GameSession> session (new GameSession {windowWidth, windowHeight, seed, false});
+        TrackDisplay trackDisplay;
+        ItemsDisplay itemsDisplay;
+        PlayerDisplay playerDisplay;
+        TrackView trackView;
+        ItemsView itemsView;
+        bool createTextures = true;
+        Uint64 tick = 0;
+
+        auto displayPart = [&](Renderer& renderer, int part, const RenderState& state) {
+            Camera camera {state.cameraX, windowWidth, windowHeight};
+            switch (part) {
+                case 0: trackDisplay.DisplayBackground(renderer, windowWidth, windowHeight); break;
+                case 1: trackDisplay.DisplayTrack(renderer, trackView, camera); break;
+                case 2: playerDisplay.Display(renderer, state.playerx, state.playery,
+                                              session->GetPlayer().GetPlayerWidthHeight()); break;
+                case 3: itemsDisplay.DisplayItems(renderer, itemsView, camera); break;
+                default: itemsDisplay.DisplayScoreLives(renderer, windowWidth, windowHeight,
+                                                        session->GetCollectables().GetScore(),
+                                                        session->GetPlayer().GetLives(),
+                                                        playerDisplay.GetTexture()); break;
+            }
+        };
+
+        for (int f = 0; f < frames; f++) {
+            if (session->GameOver()) {
+                session.reset(new GameSession {windowWidth, windowHeight, ++seed, false});
+                createTextures = true;
+                sessions++;
+            }
+
+            for (Uint64 t = 0; t < ticksPerFrame && !session->GameOver(); t++, tick++) {
+                SessionInputs inputs;
+                inputs.jumpHeld = (tick % 900) < 350;
+                session->Step(inputs);
+            }
+
+            // the displays of a new session are created as the game loop does, as its levels are numbered from 1 again
+            if (createTextures) {
+                trackDisplay = TrackDisplay {};
+                itemsDisplay = ItemsDisplay {};
+                trackDisplay.CreateTextures(assets);
+                itemsDisplay.CreateTextures(assets);
+                playerDisplay.CreateTexture(assets);
+                createTextures = false;
+            }
+            session->CaptureViews(trackView, itemsView);
+            RenderState state = session->GetRenderState(0);
+
+            // recorded first, as the hud is only recomposed by the first display after the score changes
+            auto start = std::chrono::steady_clock::now();
+            for (int part = 0; part < parts; part++) {
+                RenderStats before = recorder.GetCurrentStats();
+                displayPart(recorder, part, state);
+                partStats[part] += recorder.GetCurrentStats() - before;
+            }
+            recorder.Present();
+            recordMs += MsSince(start);
+
+            start = std::chrono::steady_clock::now();
+            for (int part = 0; part < parts; part++) displayPart(nullRenderer, part, state);
+            nullMs += MsSince(start);
+
+            start = std::chrono::steady_clock::now();
+            software.Clear({0, 0, 0, 255});
+            recorder.Playback(software);
+            software.Present();
+            playbackMs += MsSince(start);
+        }
+    }
+
+    // per frame stats of each part, then of the whole frame
+    const double windowPixels = double(windowWidth) * windowHeight;
+    printf("RENDER BENCH | frames: %d, sessions: %d, window: %dx%d\n", frames, sessions, windowWidth, windowHeight);
+    for (int part = 0; part <= parts; part++) {
+        const RenderStats& stats = (part < parts) ? partStats[part] : recorder.GetTotalStats();
+        printf("RENDER BENCH | %-10s | draw calls: %5.1f | sprites: %6.1f | texture switches: %4.1f | "
+               "target switches: %4.2f | pixels covered: %8.0f (%4.2fx window)\n",
+               (part < parts) ? partNames[part] : "frame", double(stats.drawCalls) / frames,
+               double(stats.sprites) / frames, double(stats.textureSwitches) / frames,
+               double(stats.targetSwitches) / frames, double(stats.pixelsCovered) / frames,
+               double(stats.pixelsCovered) / frames / windowPixels);
+    }
+    printf("RENDER BENCH | cpu per frame | null renderer: %.4f ms | recording: %.4f ms | software playback: %.3f ms\n",
+           nullMs / frames, recordMs / frames, playbackMs / frames);
+
+    return 0;
+}
+
+
+
+
+
+static int BenchColumns() {
+    /*
+     * Displays the track of a level at 1080p and 1440p window heights, with each column drawn a tile at a time, from a
+     * column strip, and from terrain pages, and reports the sprites, draw submissions, texture switches and pixels
+     * covered per frame. Pages are composed as the camera reaches them, so their cost is included. Frame time is the
+     * cpu time of displaying the track into a RecordingRenderer, and of playing it back to a software renderer.
+     */
+    const int frames = 2000;
+    const int heights[] = {1078, 1438};
+
+    for (int height : heights) {
+        int width = height * 9/7;                                                                                       // window ratio used by main
+        BenchSoftwareRenderer softwareRenderer {width, height};
+        if (softwareRenderer.renderer == nullptr) {
+            printf("COLUMNS BENCH | ERROR: could not create a software renderer: %s\n", SDL_GetError());
+            return 1;
+        }
+        SDLRenderer software {softwareRenderer.renderer};
+        AssetCache assets(softwareRenderer.renderer);
+
+        GameSession session {width, height, 1, false};
+        const Track& track = session.GetTrack();
+        TrackView view;
+        double levelWidth = track.GetTrackStartEndIndex().last * double(BENCH_TILE_SIZE);
+
+        const char* modes[] = {"tiles", "strips", "pages"};
+        for (int mode = 0; mode < 3; mode++) {
+            TrackDisplay display;
+            display.CreateTextures(assets);
+            display.SetColumnStrips(mode >= 1);
+            display.SetTerrainPages(mode == 2);
+            RecordingRenderer recorder {width, height};
+            double recordMs = 0, playbackMs = 0;
+
+            for (int f = 0; f < frames; f++) {
+                Camera camera {levelWidth * f / frames, width, height};
+                CaptureBenchView(track, camera, view);
+
+                auto start = std::chrono::steady_clock::now();
+                display.DisplayTrack(recorder, view, camera);
+                recorder.Present();
+                recordMs += MsSince(start);
+
+                start = std::chrono::steady_clock::now();
+                recorder.Playback(software);
+                software.Present();
+                playbackMs += MsSince(start);
+            }
+
+            const RenderStats& stats = recorder.GetTotalStats();
+            printf("COLUMNS BENCH | %4dx%4d | %-6s | sprites: %6.1f | submissions: %4.1f | texture switches: %4.1f | "
+                   "pixels: %.2f M | display: %.4f ms | software playback: %.3f ms\n", width, height, modes[mode],
+                   double(stats.sprites) / frames, double(stats.drawCalls) / frames,
+                   double(stats.textureSwitches) / frames, double(stats.pixelsCovered) / frames / 1e6,
+                   recordMs / frames, playbackMs / frames);
+        }
+    }
+
+    return 0;
+}
+
+
+
+
+
+static int BenchBatch() {
+    /*
+     * Plays a session at 60 frames per second, displaying the track, player and items of each frame with sprite
+     * batching disabled and then enabled. Reports the draw submissions, sprites and texture switches per frame of each,
+     * and the cpu time of displaying into a RecordingRenderer and of playing the frame back to a software renderer.
+     */
+    const int windowWidth = 1386, windowHeight = 1078;
+    const int frames = 3000;
+    const Uint64 ticksPerFrame = 16;
+
+    BenchSoftwareRenderer softwareRenderer {windowWidth, windowHeight};
+    if (softwareRenderer.renderer == nullptr) {
+        printf("BATCH BENCH | ERROR: could not create a software renderer: %s\n", SDL_GetError());
+        return 1;
+    }
+
+    SDLRenderer software {softwareRenderer.renderer};
+    RecordingRenderer recorders[2] {{windowWidth, windowHeight}, {windowWidth, windowHeight}};
+    double displayMs[2] {}, playbackMs[2] {};
+    int displayed = 0;
+
+    {
+        AssetCache assets(softwareRenderer.renderer);
+        GameSession session {windowWidth, windowHeight, 1, false};
+        TrackDisplay trackDisplay;
+        ItemsDisplay itemsDisplay;
+        PlayerDisplay playerDisplay;
+        trackDisplay.CreateTextures(assets);
+        itemsDisplay.CreateTextures(assets);
+        playerDisplay.CreateTexture(assets);
+        TrackView trackView;
+        ItemsView itemsView;
+        Uint64 tick = 0;
+
+        for (; displayed < frames && !session.GameOver(); displayed++) {
+            for (Uint64 t = 0; t < ticksPerFrame && !session.GameOver(); t++, tick++) {
+                SessionInputs inputs;
+                inputs.jumpHeld = (tick % 900) < 350;
+                session.Step(inputs);
+            }
+
+            session.CaptureViews(trackView, itemsView);
+            RenderState state = session.GetRenderState(0);
+            Camera camera {state.cameraX, windowWidth, windowHeight};
+            Size2D playerSize = session.GetPlayer().GetPlayerWidthHeight();
+
+            for (int batched = 0; batched <= 1; batched++) {
+                trackDisplay.SetSpriteBatching(batched == 1);
+                itemsDisplay.SetSpriteBatching(batched == 1);
+                auto start = std::chrono::steady_clock::now();
+                trackDisplay.DisplayTrack(recorders[batched], trackView, camera);
+                playerDisplay.Display(recorders[batched], state.playerx, state.playery, playerSize);
+                itemsDisplay.DisplayItems(recorders[batched], itemsView, camera);
+                recorders[batched].Present();
+                displayMs[batched] += MsSince(start);
+
+                start = std::chrono::steady_clock::now();
+                recorders[batched].Playback(software);
+                software.Present();
+                playbackMs[batched] += MsSince(start);
+            }
+        }
+    }
+
+    printf("BATCH BENCH | frames: %d, window: %dx%d, track, player and items\n", displayed, windowWidth, windowHeight);
+    for (int batched = 0; batched <= 1; batched++) {
+        const RenderStats& stats = recorders[batched].GetTotalStats();
+        printf("BATCH BENCH | %-9s | submissions: %6.1f | sprites: %6.1f | texture switches: %5.1f | "
+               "display: %.4f ms | software playback: %.3f ms\n", batched ? "batched" : "unbatched",
+               double(stats.drawCalls) / displayed, double(stats.sprites) / displayed,
+               double(stats.textureSwitches) / displayed, displayMs[batched] / displayed,
+               playbackMs[batched] / displayed);
+    }
+
+    return displayed > 0 ? 0 : 1;
+}
+
+
+
+
+
+static int BenchPacing() {
+    /*
+     * Paces an empty loop at a range of frame rates for a second each, and reports the mean frame time, its jitter and
+     * worst case, and the time per frame spent sleeping and spinning. Spinning is the only time the pacer keeps a core
+     * busy, where an unpaced loop would keep it busy for the whole frame.
+     */
+    const double rates[] = {30, 60, 144, 240};
+
+    for (double rate : rates) {
+        FramePacer pacer {rate, rate};
+        auto start = std::chrono::steady_clock::now();
+        while (MsSince(start) < 1000) pacer.Wait();
+
+        FramePacerStats stats = pacer.GetStats();
+        printf("PACING BENCH | %3.0f fps | target: %6.3f ms | mean: %6.3f ms | jitter: %.3f ms | max: %6.3f ms | "
+               "sleep: %6.3f ms | spin: %.3f ms (%.1f%% busy)\n", rate, stats.targetMs, stats.meanMs, stats.jitterMs,
+               stats.maxMs, stats.sleepMs, stats.spinMs, 100.0 * stats.spinMs / std::max(stats.meanMs, 1e-9));
+    }
+
+    return 0;
+}
+
+
+
+
+
+int RunBenchmark(const std::string& name) {
+    if (name == "lookup") return BenchTrackLookup();
+    if (name == "culling") return BenchCulling();
+    if (name == "collision") return BenchCollision();
+    if (name == "overlap") return BenchOverlapKernel();
+    if (name == "transition") return BenchLevelTransition();
+    if (name == "endless") return BenchEndless();
+    if (name == "random") return BenchRandom();
+    if (name == "replay") return BenchReplay();
+    if (name == "log") return BenchLog();
+    if (name == "alloc") return BenchAllocations();
+    if (name == "arena") return BenchArena();
+    if (name == "render") return BenchRender();
+    if (name == "columns") return BenchColumns();
+    if (name == "batch") return BenchBatch();
+    if (name == "pacing") return BenchPacing();
+
+    printf("Unknown benchmark: %s\n", name.c_str());
+    printf("Available benchmarks: lookup, culling, collision, overlap, transition, endless, random, replay, log, alloc, "
+           "arena, render, columns, batch, pacing\n");
+    return 1;
+}
@@ -0,0 +1,16 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#ifndef CPP_PROGRAMMINGPROJECT_BENCHMARKS_H
+#define CPP_PROGRAMMINGPROJECT_BENCHMARKS_H
+
+#include "GameCore.h"
+#include "Track.h"
+#include "Player.h"
+#include "TrackBonusItems.h"
+
+// Runs the named benchmark without a window, returns the program exit code
+int RunBenchmark(const std::string& name);
+
+#endif //CPP_PROGRAMMINGPROJECT_BENCHMARKS_H
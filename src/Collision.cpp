@@ -0,0 +1,100 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#include "Collision.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+// float positions are rounded, so the kernel is very slightly generous and hits are confirmed by PlayerCollision
+static const float OVERLAP_TOLERANCE = 0.01f;
+
+void AABBArrays::Disable(size_t index) {
+    y[index] = FLT_MAX;
+}
+
+double AABBArrays::LeftEdge(size_t index) const {
+    return originx + x[index] - halfWidth[index];
+}
+
+double AABBArrays::RightEdge(size_t index) const {
+    return originx + x[index] + halfWidth[index];
+}
+
+
+
+
+
+unsigned OverlapMaskScalar(const AABBArrays& boxes, size_t first, const ObjectStruct& player) {
+    // Reference version of the kernel, also used where no SIMD instructions are available
+    float px = float(player.gamex - boxes.originx), py = float(player.gamey);
+    float phw = player.width / 2.0f + OVERLAP_TOLERANCE, phh = player.height / 2.0f + OVERLAP_TOLERANCE;
+
+    unsigned mask = 0;
+    for (int lane = 0; lane < AABBArrays::LANES; lane++) {
+        size_t i = first + lane;
+        bool overlapx = std::abs(boxes.x[i] - px) <= phw + boxes.halfWidth[i];
+        bool overlapy = std::abs(boxes.y[i] - py) <= phh + boxes.halfHeight[i];
+        if (overlapx && overlapy) mask |= 1u << lane;
+    }
+    return mask;
+}
+
+#if defined(__AVX2__)
+unsigned OverlapMask(const AABBArrays& boxes, size_t first, const ObjectStruct& player) {
+    // AVX2, tests all 8 lanes at once
+    const __m256 absMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    __m256 px = _mm256_set1_ps(float(player.gamex - boxes.originx));
+    __m256 py = _mm256_set1_ps(float(player.gamey));
+    __m256 phw = _mm256_set1_ps(player.width / 2.0f + OVERLAP_TOLERANCE);
+    __m256 phh = _mm256_set1_ps(player.height / 2.0f + OVERLAP_TOLERANCE);
+
+    __m256 dx = _mm256_and_ps(_mm256_sub_ps(_mm256_loadu_ps(&boxes.x[first]), px), absMask);
+    __m256 dy = _mm256_and_ps(_mm256_sub_ps(_mm256_loadu_ps(&boxes.y[first]), py), absMask);
+    __m256 overlapx = _mm256_cmp_ps(dx, _mm256_add_ps(phw, _mm256_loadu_ps(&boxes.halfWidth[first])), _CMP_LE_OQ);
+    __m256 overlapy = _mm256_cmp_ps(dy, _mm256_add_ps(phh, _mm256_loadu_ps(&boxes.halfHeight[first])), _CMP_LE_OQ);
+
+    return unsigned(_mm256_movemask_ps(_mm256_and_ps(overlapx, overlapy)));
+}
+
+const char* OverlapKernelName() {
+    return "AVX2";
+}
+#elif defined(__SSE2__) || defined(_M_X64)
+static unsigned OverlapMask4(const AABBArrays& boxes, size_t first, __m128 px, __m128 py, __m128 phw, __m128 phh) {
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+
+    __m128 dx = _mm_and_ps(_mm_sub_ps(_mm_loadu_ps(&boxes.x[first]), px), absMask);
+    __m128 dy = _mm_and_ps(_mm_sub_ps(_mm_loadu_ps(&boxes.y[first]), py), absMask);
+    __m128 overlapx = _mm_cmple_ps(dx, _mm_add_ps(phw, _mm_loadu_ps(&boxes.halfWidth[first])));
+    __m128 overlapy = _mm_cmple_ps(dy, _mm_add_ps(phh, _mm_loadu_ps(&boxes.halfHeight[first])));
+
+    return unsigned(_mm_movemask_ps(_mm_and_ps(overlapx, overlapy)));
+}
+
+unsigned OverlapMask(const AABBArrays& boxes, size_t first, const ObjectStruct& player) {
+    // SSE2, tests the 8 lanes as two groups of 4
+    __m128 px = _mm_set1_ps(float(player.gamex - boxes.originx));
+    __m128 py = _mm_set1_ps(float(player.gamey));
+    __m128 phw = _mm_set1_ps(player.width / 2.0f + OVERLAP_TOLERANCE);
+    __m128 phh = _mm_set1_ps(player.height / 2.0f + OVERLAP_TOLERANCE);
+
+    return OverlapMask4(boxes, first, px, py, phw, phh) | (OverlapMask4(boxes, first + 4, px, py, phw, phh) << 4);
+}
+
+const char* OverlapKernelName() {
+    return "SSE2";
+}
+#else
+unsigned OverlapMask(const AABBArrays& boxes, size_t first, const ObjectStruct& player) {
+    return OverlapMaskScalar(boxes, first, player);
+}
+
+const char* OverlapKernelName() {
+    return "scalar";
+}
+#endif
@@ -0,0 +1,64 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#ifndef CPP_PROGRAMMINGPROJECT_COLLISION_H
+#define CPP_PROGRAMMINGPROJECT_COLLISION_H
+
+#include "Track.h"
+#include <cfloat>
+
+/*
+ * Positions and extents of a list of TrackObjects, stored as parallel float arrays so the overlap kernel can test the
+ * player against 8 objects at a time. Positions are stored relative to originx, to keep float precision far along
+ * the track. The arrays are padded with LANES inactive entries, which never overlap, so a block of 8 can start at any
+ * object. Objects that can no longer be collided with are also inactive.
+ */
+struct AABBArrays {
+    static const int LANES = 8;
+
+    double originx = 0;
+    ArenaVector<float> x, y;
+    ArenaVector<float> halfWidth, halfHeight;
+    size_t count = 0;
+
+    AABBArrays() = default;
+    explicit AABBArrays(Arena* arena) : x(ArenaAllocator<float>(arena)), y(ArenaAllocator<float>(arena)),
+                                        halfWidth(ArenaAllocator<float>(arena)),
+                                        halfHeight(ArenaAllocator<float>(arena)) {}
+
+    template <typename Objects>
+    void Assign(Objects &objects);
+    void Disable(size_t index);
+
+    double LeftEdge(size_t index) const;
+    double RightEdge(size_t index) const;
+};
+
+template <typename Objects>
+void AABBArrays::Assign(Objects &objects) {
+    // Copies the positions of the objects, keeping the allocated capacity
+    count = objects.size();
+    originx = objects.empty() ? 0 : objects.front().GetStruct()->gamex;
+
+    size_t padded = count + LANES;
+    x.assign(padded, 0);
+    y.assign(padded, FLT_MAX);                                                                                          // inactive unless set below
+    halfWidth.assign(padded, 0);
+    halfHeight.assign(padded, 0);
+
+    for (size_t i = 0; i < count; i++) {
+        const ObjectStruct* object = objects[i].GetStruct();
+        x[i] = float(object->gamex - originx);
+        halfWidth[i] = object->width / 2.0f;
+        halfHeight[i] = object->height / 2.0f;
+        if (objects[i].CollisionEnabled()) y[i] = float(object->gamey);
+    }
+}
+
+// Bit i of the result is set if the player overlaps object first + i, for objects first to first + LANES - 1
+unsigned OverlapMask(const AABBArrays& boxes, size_t first, const ObjectStruct& player);
+unsigned OverlapMaskScalar(const AABBArrays& boxes, size_t first, const ObjectStruct& player);
+const char* OverlapKernelName();
+
+#endif //CPP_PROGRAMMINGPROJECT_COLLISION_H
@@ -0,0 +1,121 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#include "FramePacer.h"
+#include <thread>
+
+constexpr double FramePacer::MIN_SLEEP_MARGIN_MS;
+constexpr double FramePacer::MAX_SLEEP_MARGIN_MS;
+
+FramePacer::FramePacer(double activeFrameRate, double idleFrameRate) {
+    counterPerMs = double(SDL_GetPerformanceFrequency()) / 1000.0;
+    SetRates(activeFrameRate, idleFrameRate);
+}
+
+Uint64 FramePacer::GetPeriod() const {
+    double rate = GetTargetRate();
+    return (rate > 0) ? Uint64(1000.0 / rate * counterPerMs) : 0;
+}
+
+void FramePacer::Wait() {
+    /*
+     * Waits until the next frame is due, then records the time since the last call. Sleeps are made in steps until
+     * the time left is within the margin, as a sleep may wake early or late, and the margin is widened whenever a
+     * sleep overshoots it.
+     */
+    Uint64 period = GetPeriod();
+    Uint64 now = SDL_GetPerformanceCounter();
+    double slept = 0, spun = 0;
+
+    if (period > 0) {
+        Uint64 deadline = nextDeadline;
+        if (deadline == 0 || now >= deadline + period) deadline = now;                                                  // first frame at this rate, or more than a frame late
+
+        // sleep until just before the deadline
+        while (now < deadline) {
+            double remainingMs = double(deadline - now) / counterPerMs;
+            if (remainingMs <= sleepMarginMs) break;
+
+            double requestedMs = remainingMs - sleepMarginMs;
+            std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(requestedMs));
+            Uint64 woke = SDL_GetPerformanceCounter();
+            double actualMs = double(woke - now) / counterPerMs;
+            slept += actualMs;
+            now = woke;
+
+            // keep the margin wide enough for recent oversleeps, narrowing it slowly once they stop
+            sleepMarginMs = std::max(sleepMarginMs * 0.99, actualMs - requestedMs);
+            sleepMarginMs = std::min(std::max(sleepMarginMs, MIN_SLEEP_MARGIN_MS), MAX_SLEEP_MARGIN_MS);
+        }
+
+        // spin for the rest
+        Uint64 spinStart = now;
+        while (now < deadline) now = SDL_GetPerformanceCounter();
+        spun = double(now - spinStart) / counterPerMs;
+
+        nextDeadline = deadline + period;
+    }
+
+    if (lastFrame != 0) {
+        int slot = int(frames % WINDOW_FRAMES);
+        frameMs[slot] = float(double(now - lastFrame) / counterPerMs);
+        sleptMs[slot] = float(slept);
+        spunMs[slot] = float(spun);
+        frames++;
+    }
+    lastFrame = now;
+}
+
+void FramePacer::SetIdle(bool isIdle) {
+    if (isIdle == idle) return;
+    idle = isIdle;
+    nextDeadline = 0;
+    ResetStats();
+}
+
+void FramePacer::SetRates(double activeFrameRate, double idleFrameRate) {
+    activeRate = std::max(activeFrameRate, 0.0);
+    idleRate = std::max(idleFrameRate, 0.0);
+    nextDeadline = 0;
+    ResetStats();
+}
+
+void FramePacer::ResetStats() {
+    // The next frame time is measured from the next Wait
+    frames = 0;
+    lastFrame = 0;
+}
+
+
+
+
+
+double FramePacer::GetTargetRate() const {
+    return idle ? idleRate : activeRate;
+}
+
+FramePacerStats FramePacer::GetStats() const {
+    FramePacerStats stats;
+    int count = int(std::min<Uint64>(frames, WINDOW_FRAMES));
+    double rate = GetTargetRate();
+    stats.frames = Uint64(count);
+    stats.targetMs = (rate > 0) ? 1000.0 / rate : 0;
+    if (count == 0) return stats;
+
+    double total = 0, slept = 0, spun = 0;
+    for (int i = 0; i < count; i++) {
+        total += frameMs[i];
+        slept += sleptMs[i];
+        spun += spunMs[i];
+        stats.maxMs = std::max(stats.maxMs, double(frameMs[i]));
+    }
+    stats.meanMs = total / count;
+    stats.sleepMs = slept / count;
+    stats.spinMs = spun / count;
+
+    double variance = 0;
+    for (int i = 0; i < count; i++) variance += (frameMs[i] - stats.meanMs) * (frameMs[i] - stats.meanMs);
+    stats.jitterMs = std::sqrt(variance / count);
+    return stats;
+}
@@ -0,0 +1,66 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#ifndef CPP_PROGRAMMINGPROJECT_FRAMEPACER_H
+#define CPP_PROGRAMMINGPROJECT_FRAMEPACER_H
+
+#include "GameCore.h"
+#include <array>
+
+// Frame times over the pacer's window, and where the time waiting was spent
+struct FramePacerStats {
+    Uint64 frames = 0;                                                                                                  // in the window
+    double targetMs = 0;                                                                                                // 0 if unlimited
+    double meanMs = 0;
+    double jitterMs = 0;                                                                                                // standard deviation of the frame time
+    double maxMs = 0;
+    double sleepMs = 0;                                                                                                 // per frame, sleeping
+    double spinMs = 0;                                                                                                  // per frame, spinning on the clock
+};
+
+/*
+ * Holds a loop to a target frame rate, waiting after each present until the next frame is due. It sleeps until just
+ * before the deadline, then spins on the performance counter for the rest, so the deadline is met closely without
+ * busying a core for the whole frame. The margin left for spinning follows how late sleeps have woken recently.
+ *
+ * There are two rates: the active rate for gameplay, and a lower idle rate for screens that barely change, such as the
+ * menu or a paused game. A rate of 0 is unlimited, for when vsync already paces presents. Deadlines follow on from
+ * one another rather than from when each wait began, so the rate holds on average. If a frame is late by more than a
+ * whole frame, the pacer starts again from it instead of hurrying the next frames to catch up.
+ */
+class FramePacer {
+    private:
+        static const int WINDOW_FRAMES = 240;
+        static constexpr double MIN_SLEEP_MARGIN_MS = 0.25;
+        static constexpr double MAX_SLEEP_MARGIN_MS = 4.0;
+
+        double activeRate, idleRate;
+        bool idle = false;
+        double counterPerMs;
+        Uint64 nextDeadline = 0;                                                                                        // performance counter, 0 once the rate changes
+        double sleepMarginMs = 1.0;
+
+        // frame times, and time spent waiting, over the last WINDOW_FRAMES frames
+        Uint64 lastFrame = 0;
+        std::array<float, WINDOW_FRAMES> frameMs {};
+        std::array<float, WINDOW_FRAMES> sleptMs {};
+        std::array<float, WINDOW_FRAMES> spunMs {};
+        Uint64 frames = 0;
+
+        Uint64 GetPeriod() const;
+
+    public:
+        FramePacer(double activeFrameRate, double idleFrameRate);
+
+        void Wait();
+        void SetIdle(bool isIdle);
+        void SetRates(double activeFrameRate, double idleFrameRate);
+        void ResetStats();
+
+        // Getters
+        double GetTargetRate() const;
+        FramePacerStats GetStats() const;
+};
+
+#endif //CPP_PROGRAMMINGPROJECT_FRAMEPACER_H
@@ -6,6 +6,32 @@
 #define CPP_PROGRAMMINGPROJECT_GAMEMENUANDWINDOWSETUP_CPP
 
 #include "GameCore.h"
+#include "AssetCache.h"
+#include "TextRenderer.h"
+#include "Renderer.h"
+
+void Text::ConstructRect(int x, int y, int w, double reqh, bool fitToHeight) {
+    int h = int(reqh);
+
+    if (fitToHeight && atlas) {                                                                                         // ensures a ratio between width and height
+        w = atlas->MeasureWidth(text, h);
+    }
+    x = x - w/2;
+    y = y - h/2;
+    textRect = {x, y, w, h};
+}
+
+void Text::SetAtlas(std::shared_ptr<GlyphAtlas> textAtlas) {
+    atlas = std::move(textAtlas);
+}
+
+void Text::Display(Renderer& renderer) const {
+    if (atlas) atlas->Draw(renderer, text, textRect);
+}
+
+
+
+
 
 Menu::Menu(int w, int h) {
     width = w;
@@ -15,43 +41,47 @@ Menu::Menu(int w, int h) {
     bgImageRect = {0, 0, width, height};
 }
 
-void Menu::CreateTextures(SDL_Renderer* RENDERER) {
+void Menu::CreateTextures(AssetCache& assets) {
     /*
      * This function constructs and stores the textures and font that is used by the Start Screen for displaying text
-     * and the background image. This includes the start prompt, and high scores label textures.
+     * and the background image. This includes the start prompt, and high scores labels. The glyph atlas of the font and
+     * the background are fetched from the asset cache, so are only loaded once.
      */
     textWidgets = {};
 
-    // create text font:
-    std::string fontPath = "../Resources/CookieCrisp/CookieCrisp-L36ly.ttf";
-    textFont = TTF_OpenFont(fontPath.c_str(), 200);
+    // fetch text font glyph atlas:
+    textAtlas = assets.GetGlyphAtlas("../Resources/CookieCrisp/CookieCrisp-L36ly.ttf", 200);
 
-    // Create background image playerTexture
-    std::string bgPath = "../Resources/Images/Backgrounds/MainCaveBackground.png";
-    surface = IMG_Load(bgPath.c_str());
-    bgImageTexture = SDL_CreateTextureFromSurface(RENDERER, surface);
-    SDL_FreeSurface(surface);
+    // fetch background image texture
+    bgImageTexture = assets.GetTexture("../Resources/Images/Backgrounds/MainCaveBackground.png");
 
     // Create start prompt playerTexture
     Text startPrompt;
     startPrompt.text = "PRESS SPACE TO BEGIN!";
     startPrompt.ConstructRect(width / 2, (height * 15/16),width / 2, height / 16.0);
-    startPrompt.CreateTexture(RENDERER, textFont);
+    startPrompt.SetAtlas(textAtlas);
     textWidgets.push_back(startPrompt);
 
+    // Create endless mode prompt
+    Text endlessPrompt;
+    endlessPrompt.text = "PRESS E FOR ENDLESS MODE";
+    endlessPrompt.ConstructRect(width / 2, (height * 14/16),width / 2, height / 16.0);
+    endlessPrompt.SetAtlas(textAtlas);
+    textWidgets.push_back(endlessPrompt);
+
     // Create high scores text
     Text hsHeader;
     hsHeader.text = "Top 5 High Scores:";
     hsHeader.ConstructRect(width/2, height * 8/16, width/2, height / 16.0);
-    hsHeader.CreateTexture(RENDERER, textFont);
+    hsHeader.SetAtlas(textAtlas);
     textWidgets.push_back(hsHeader);
 
     int xScore = width/3;
     int yScore = height * 9/16;
 
     for (HighScore &score : highScores) {
-        score.scoreText.CreateTexture(RENDERER, textFont);
-        score.dateText.CreateTexture(RENDERER, textFont);
+        score.scoreText.SetAtlas(textAtlas);
+        score.dateText.SetAtlas(textAtlas);
 
         score.scoreText.ConstructRect(xScore, yScore, 0, height/16.0, true);
         score.dateText.ConstructRect(2 * xScore, yScore, 0, height/16.0, true);
@@ -61,8 +91,6 @@ void Menu::CreateTextures(SDL_Renderer* RENDERER) {
         textWidgets.push_back(score.scoreText);
         textWidgets.push_back(score.dateText);
     }
-
-    TTF_CloseFont(textFont);
 }
 
 void Menu::ObtainScoreInfo() {
@@ -133,16 +161,16 @@ void Menu::SaveScore(HighScore& newScore) {
     writeScoreFile.close();
 }
 
-void Menu::Display(SDL_Renderer* RENDERER) {
+void Menu::Display(Renderer& renderer) {
     /*
      * This function displays the background of the start screen, and then overlays all text on top of it by iterating
      * though a vector which holds all text objects.
      */
 
-    SDL_RenderCopy(RENDERER, bgImageTexture, nullptr, &bgImageRect);                               // Display background image
+    renderer.Copy(bgImageTexture.get(), nullptr, bgImageRect);                               // Display background image
 
-    for (Text textWidget : textWidgets) {                                                                               // Display textWidgets
-        textWidget.Display(RENDERER);
+    for (const Text &textWidget : textWidgets) {                                                                        // Display textWidgets
+        textWidget.Display(renderer);
     }
 }
 
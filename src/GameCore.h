@@ -17,36 +17,32 @@
 #include <fstream>
 #include <algorithm>
 #include <ctime>
+#include <chrono>
+#include <memory>
 // Define the global variables
 
+class AssetCache;
+class GlyphAtlas;
+class Renderer;
+
+// Pairs of values returned by the game object getters, rather than a std::vector, so the game tick allocates nothing
+struct Vector2D {
+    double x = 0, y = 0;
+};
+
+struct Size2D {
+    int w = 0, h = 0;
+};
+
 struct Text {
+    // text drawn from a shared glyph atlas, so no texture is created per text
     SDL_Rect textRect {};
-    SDL_Texture* textTexture {};
-    SDL_Surface* textSurface {};
+    std::shared_ptr<GlyphAtlas> atlas {};
     std::string text;
 
-    void ConstructRect(int x, int y, int w, double reqh, bool fitToHeight = false) {
-        int h = int(reqh);
-
-        if (fitToHeight) {                                                                                              // ensures a ratio between width and height
-            SDL_QueryTexture(textTexture, nullptr, nullptr, &w, &h);
-            w = int(w / (h / reqh));
-            h = int (h / (h / reqh));
-        }
-        x = x - w/2;
-        y = y - h/2;
-        textRect = {x, y, w, h};
-    }
-
-    void CreateTexture(SDL_Renderer* RENDERER, TTF_Font* textFont) {
-        textSurface = TTF_RenderText_Blended(textFont, text.c_str(), {255, 255, 255});
-        textTexture = SDL_CreateTextureFromSurface(RENDERER, textSurface);
-        SDL_FreeSurface(textSurface);
-    }
-
-    void Display(SDL_Renderer* RENDERER) {
-        SDL_RenderCopy(RENDERER, textTexture, nullptr, &textRect);
-    }
+    void ConstructRect(int x, int y, int w, double reqh, bool fitToHeight = false);
+    void SetAtlas(std::shared_ptr<GlyphAtlas> textAtlas);
+    void Display(Renderer& renderer) const;
 };
 
 struct HighScore {
@@ -72,10 +68,9 @@ class Menu {
         std::vector<HighScore> highScores {};
 
         // SDL and display components
-        SDL_Surface* surface {};
         SDL_Rect bgImageRect {};
-        SDL_Texture* bgImageTexture{};
-        TTF_Font* textFont{};
+        std::shared_ptr<SDL_Texture> bgImageTexture{};
+        std::shared_ptr<GlyphAtlas> textAtlas{};
 
         int width;
         int height;
@@ -85,10 +80,10 @@ class Menu {
 
     public:
         Menu(int w, int h);
-        void CreateTextures(SDL_Renderer* RENDERER);
+        void CreateTextures(AssetCache& assets);
         void ObtainScoreInfo();
         void SaveScore( HighScore& newScore);
-        void Display(SDL_Renderer* RENDERER);
+        void Display(Renderer& renderer);
 
 };
 
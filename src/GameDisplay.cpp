@@ -0,0 +1,401 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#include "GameDisplay.h"
+#include "Trace.h"
+#include "TextRenderer.h"
+#include "Renderer.h"
+
+static bool OverlapsCamera(const ObjectStruct& object, const Camera& camera) {
+    return object.gamex + object.width/2.0 >= camera.x && object.gamex - object.width/2.0 <= camera.x + camera.width;
+}
+
+static SDL_Rect ObjectRect(const ObjectStruct& object, const Camera& camera) {
+    // set rect position to top left of desired model position
+    int rectx = int(object.gamex - camera.x - object.width/2.0);
+    int recty = int(object.gamey - object.height/2.0);
+    return {rectx, recty, object.width, object.height};
+}
+
+
+
+
+
+void TrackDisplay::CreateTextures(AssetCache& assets) {
+    // Fetch toplevel, toplevel bg deco, checkpoint deco, filler, background and obstacle textures
+    TRACE_SCOPE("TrackDisplay::CreateTextures", "assets");
+    toplevelTexture = assets.GetTexture("../Resources/Images/Track/TrackToplevel.png");
+    ttlBgTexture = assets.GetTexture("../Resources/Images/Track/TrackToplevelBGDeco.png");
+    ttlCheckpointTexture = assets.GetTexture("../Resources/Images/Track/TrackToplevelCheckpointDeco.png");
+    trackFillerTexture = assets.GetTexture("../Resources/Images/Track/TrackFiller.png");
+    backgroundTexture = assets.GetTexture("../Resources/Images/Backgrounds/MainCaveBackground.png");
+    obstacleTexture = assets.GetTexture("../Resources/Images/TrackObstacles/Boulder.png");
+    assetCache = &assets;                                                                                               // column strips and pages are composed on first display
+}
+
+TileRange TrackDisplay::GetViewRange(double fromCameraX, double toCameraX, int windowWidth, int tileWidth) {
+    /*
+     * Determines the tiles a TrackView must hold to be displayed with the camera anywhere from fromCameraX to
+     * toCameraX. This includes the tiles overlapping the camera, and those of the terrain pages that are composed
+     * whilst the camera is there.
+     */
+    int width = GetPageWidth(windowWidth, tileWidth);
+    TileRange range;
+    range.first = int(std::floor(fromCameraX / tileWidth)) - 1;
+    range.last = int(std::floor((toCameraX + windowWidth) / tileWidth)) + 1;
+    if (width <= 0) return range;
+
+    range.first = std::min(range.first, GetPageRange(int(std::floor(fromCameraX / width)), width, tileWidth).first - 1);
+    range.last = std::max(range.last, GetPageRange(int(std::floor(toCameraX / width)) + TERRAIN_PAGES - 1, width,
+                                                   tileWidth).last + 1);
+    return range;
+}
+
+void TrackDisplay::DisplayTrack(Renderer& renderer, const TrackView& view, const Camera& camera) {
+    /*
+     * Displays the columns and obstacles of the view that overlap the camera, offset by the camera position. Only the
+     * tiles overlapping the camera are visited, so the cost does not depend on the length of the track.
+     *
+     * The columns of the track are drawn from terrain pages, each composed once and then copied whilst they overlap
+     * the camera. A page that can not be composed has its columns drawn directly instead, each with one copy from a
+     * column strip, or a tile at a time if render targets are not supported. Obstacles can be hidden during a level,
+     * so are always drawn directly. Everything is batched, so is submitted with one draw per texture.
+     */
+    drawCount = 0;
+    if (view.tileWidth <= 0 || view.tileHeight <= 0) return;                                                            // nothing captured yet
+
+    TileRange visible;
+    visible.first = int(std::floor(camera.x / view.tileWidth)) - 1;
+    visible.last = int(std::floor((camera.x + camera.width) / view.tileWidth)) + 1;
+
+    Size2D tile {view.tileWidth, view.tileHeight};
+    int stripRows = camera.height / tile.h + 4;                                                                         // reaches the bottom from the top of the window
+    bool stripsFit = stripRows == columnStripRows && tile.w == columnStripTile.w && tile.h == columnStripTile.h;
+    if (useColumnStrips && assetCache && !stripsFit) ComposeColumnStrips(renderer, stripRows, tile);
+
+    // pages are as wide as the window, so at most two overlap the camera, and start above the highest column
+    int windowPageWidth = GetPageWidth(camera.width, tile.w);
+    int windowPageTop = std::max(0, view.maxTrackHeight - 2 * tile.h);
+    if (windowPageWidth != pageWidth || windowPageTop != pageTop || camera.height - windowPageTop != pageHeight) {
+        pageWidth = windowPageWidth;
+        pageTop = windowPageTop;
+        pageHeight = camera.height - windowPageTop;
+        terrainPages = {};
+    }
+
+    // the pages held are of a replaced track, their textures are reused for the new one
+    if (view.level != pageLevel) {
+        for (TerrainPage& terrainPage : terrainPages) terrainPage.index = -1;
+        pageLevel = view.level;
+    }
+
+    bool drawPages = useTerrainPages && assetCache && pageWidth > 0 && pageHeight > 0;
+    int firstPage = drawPages ? int(std::floor(camera.x / pageWidth)) : 0;
+    if (drawPages) {
+        for (int page = firstPage; page <= firstPage + TERRAIN_PAGES - 1; page++) {                                     // includes the next page ahead
+            if (terrainPages[(page % TERRAIN_PAGES + TERRAIN_PAGES) % TERRAIN_PAGES].index != page) {
+                ComposeTerrainPage(renderer, page, view, camera);
+            }
+        }
+    }
+
+    // display the pages overlapping the camera, or the columns of those not composed
+    for (int page = firstPage; drawPages && page <= firstPage + 1; page++) {
+        const TerrainPage& terrainPage = terrainPages[(page % TERRAIN_PAGES + TERRAIN_PAGES) % TERRAIN_PAGES];
+        if (terrainPage.index == page) {
+            SDL_Rect pageRect {int(std::floor(double(page) * pageWidth - camera.x)), pageTop, pageWidth, pageHeight};
+            spriteBatch.Add(terrainPage.texture.get(), nullptr, pageRect);
+            drawCount++;
+            continue;
+        }
+
+        TileRange pageRange = GetPageRange(page, pageWidth, tile.w);
+        drawCount += AddColumns({std::max(visible.first, pageRange.first), std::min(visible.last, pageRange.last)},
+                                camera.x, 0, view, camera);
+    }
+    if (!drawPages) drawCount += AddColumns(visible, camera.x, 0, view, camera);
+
+    for (const ObjectStruct& obstacle : view.obstacles) {
+        if (!OverlapsCamera(obstacle, camera)) continue;
+        spriteBatch.Add(obstacleTexture.get(), nullptr, ObjectRect(obstacle, camera));
+        drawCount++;
+    }
+
+    spriteBatch.Flush(renderer);
+}
+
+int TrackDisplay::AddColumns(TileRange range, double left, int top, const TrackView& view, const Camera& camera) {
+    /*
+     * Adds the columns of the tiles in range to the sprite batch, positioned with game x position left and window y
+     * position top at the origin, reaching down to the bottom of the window. Returns the number of sprites added.
+     */
+    range.first = std::max(range.first, view.resident.first);
+    range.last = std::min(range.last, view.resident.last);
+
+    bool drawStrips = useColumnStrips && columnStrip && checkpointColumnStrip;
+    int tileWidth = view.tileWidth, tileHeight = view.tileHeight;
+    int bottom = camera.height - top;
+    int sprites = 0;
+
+    for (int ti = range.first; ti <= range.last; ti++) {
+        const TrackColumn &column = view.GetColumn(ti);
+        if (column.gap) continue;                                                                                       // gap in track so nothing to display
+
+        SDL_Rect trackRect {int(column.gamex - left - tileWidth/2.0), int(column.gamey - tileHeight/2.0) - top,
+                            tileWidth, tileHeight};
+
+        // display the column from its deco down to the last filler tile the loop below would draw
+        if (drawStrips) {
+            int fillerRows = int(std::floor((bottom + tileHeight/2.0 - trackRect.y) / tileHeight));
+            int rows = std::min(2 + std::max(fillerRows, 0), columnStripRows);
+            SDL_Rect srcRect {0, 0, tileWidth, rows * tileHeight};
+            SDL_Rect columnRect {trackRect.x, trackRect.y - tileHeight, tileWidth, rows * tileHeight};
+            spriteBatch.Add(column.checkpoint ? checkpointColumnStrip.get() : columnStrip.get(), &srcRect, columnRect);
+            sprites++;
+            continue;
+        }
+
+        // display toplevel
+        spriteBatch.Add(toplevelTexture.get(), nullptr, trackRect);
+
+        // display toplevel bg deco, switch to checkpoint deco if track is a checkpoint
+        SDL_Texture* toplevelDeco = (column.checkpoint) ? ttlCheckpointTexture.get() : ttlBgTexture.get();
+
+        trackRect.y -= tileHeight;
+        spriteBatch.Add(toplevelDeco, nullptr, trackRect);
+        trackRect.y += tileHeight;
+        sprites += 2;
+
+        // Display track filler
+        while ((trackRect.y += tileHeight) <= bottom  + tileHeight/2.0) {
+            spriteBatch.Add(trackFillerTexture.get(), nullptr, trackRect);
+            sprites++;
+        }
+    }
+
+    return sprites;
+}
+
+int TrackDisplay::GetPageWidth(int windowWidth, int tileWidth) {
+    // Pages are the window width, rounded up to a whole number of tiles
+    if (tileWidth <= 0) return 0;
+    return (windowWidth + tileWidth - 1) / tileWidth * tileWidth;
+}
+
+TileRange TrackDisplay::GetPageRange(int page, int width, int tileWidth) {
+    // Tiles with columns starting within the page
+    TileRange range;
+    range.first = int(std::ceil(double(page) * width / tileWidth));
+    range.last = int(std::ceil(double(page + 1) * width / tileWidth)) - 1;
+    return range;
+}
+
+bool TrackDisplay::ComposeTerrainPage(Renderer& renderer, int page, const TrackView& view, const Camera& camera) {
+    /*
+     * Composes the columns of a page into its slot of the ring, replacing the page held there. Returns false if the
+     * page can not be composed, because render targets are not supported, because the view does not hold all of its
+     * tiles, or in endless mode because its tiles have not all been generated yet.
+     */
+    TileRange range = GetPageRange(page, pageWidth, view.tileWidth);
+    if (range.first - 1 < view.tiles.first || range.last + 1 > view.tiles.last) return false;
+    if (view.endless && (range.first - 1 < view.resident.first || range.last + 1 > view.resident.last)) return false;
+
+    TerrainPage& terrainPage = terrainPages[(page % TERRAIN_PAGES + TERRAIN_PAGES) % TERRAIN_PAGES];
+    if (!terrainPage.texture) terrainPage.texture = assetCache->CreateRenderTarget(pageWidth, pageHeight);
+    if (!terrainPage.texture) return false;
+
+    // neighbouring columns are included in case they overlap the edges of the page
+    {
+        ScopedRenderTarget pageTarget(renderer, terrainPage.texture.get());
+        renderer.Clear({0, 0, 0, 0});
+        AddColumns({range.first - 1, range.last + 1}, double(page) * pageWidth, pageTop, view, camera);
+        spriteBatch.Flush(renderer);
+    }
+
+    terrainPage.index = page;
+    return true;
+}
+
+void TrackDisplay::ComposeColumnStrips(Renderer& renderer, int rows, Size2D tile) {
+    /*
+     * Composes a column of rows tiles, the toplevel deco above the toplevel and then filler tiles, into a strip for
+     * normal and for checkpoint columns. The strips are left empty if render targets are not supported.
+     */
+    columnStripRows = rows;
+    columnStripTile = tile;
+    columnStrip = assetCache->CreateRenderTarget(tile.w, rows * tile.h);
+    checkpointColumnStrip = assetCache->CreateRenderTarget(tile.w, rows * tile.h);
+    if (!columnStrip || !checkpointColumnStrip) return;
+
+    SDL_Texture* strips[] = {columnStrip.get(), checkpointColumnStrip.get()};
+    SDL_Texture* decos[] = {ttlBgTexture.get(), ttlCheckpointTexture.get()};
+    ScopedRenderTarget stripTarget(renderer, strips[0]);
+    for (int s = 0; s < 2; s++) {
+        renderer.SetTarget(strips[s]);
+        renderer.Clear({0, 0, 0, 0});                                                                                   // transparent above the deco
+
+        SDL_Rect tileRect {0, 0, tile.w, tile.h};
+        renderer.Copy(decos[s], nullptr, tileRect);
+        tileRect.y += tile.h;
+        renderer.Copy(toplevelTexture.get(), nullptr, tileRect);
+        while ((tileRect.y += tile.h) < rows * tile.h) {
+            renderer.Copy(trackFillerTexture.get(), nullptr, tileRect);
+        }
+    }
+}
+
+void TrackDisplay::DisplayBackground(Renderer& renderer, int windowWidth, int windowHeight) {
+    backgroundRect.w = windowWidth;
+    backgroundRect.h = windowHeight;
+
+    renderer.Copy(backgroundTexture.get(), nullptr, backgroundRect);
+}
+
+int TrackDisplay::GetDrawCount() const {
+    return drawCount;
+}
+
+void TrackDisplay::SetColumnStrips(bool enabled) {
+    // Columns are drawn a tile at a time if disabled, for comparison
+    useColumnStrips = enabled;
+}
+
+void TrackDisplay::SetTerrainPages(bool enabled) {
+    // Columns are drawn directly every frame if disabled, for comparison
+    useTerrainPages = enabled;
+}
+
+void TrackDisplay::SetSpriteBatching(bool enabled) {
+    // Sprites are copied one at a time if disabled, for comparison
+    spriteBatch.SetBatching(enabled);
+}
+
+
+
+
+
+void ItemsDisplay::CreateTextures(AssetCache& assets) {
+    // Fetches the textures for the coins and collectables, and the glyphs of the lives and score labels
+    TRACE_SCOPE("ItemsDisplay::CreateTextures", "assets");
+    coinTexture = assets.GetTexture("../Resources/Images/Coin/100Coin_ratio_1-1.png");
+    collectableTexture = assets.GetTexture("../Resources/Images/Coin/SpecialCoin_Star.png");
+
+    assetCache = &assets;
+    hudAtlas = assets.GetGlyphAtlas("../Resources/CookieCrisp/CookieCrisp-L36ly.ttf", 200);
+}
+
+int ItemsDisplay::AddItems(const std::vector<ObjectStruct>& items, SDL_Texture* texture, const Camera& camera) {
+    // Adds the items overlapping the camera to the sprite batch, returning the number added
+    int added = 0;
+    for (const ObjectStruct& item : items) {
+        if (!OverlapsCamera(item, camera)) continue;
+        spriteBatch.Add(texture, nullptr, ObjectRect(item, camera));
+        added++;
+    }
+    return added;
+}
+
+void ItemsDisplay::DisplayItems(Renderer& renderer, const ItemsView& view, const Camera& camera) {
+    // Display the coin and collectable items that are within the camera, with one draw per texture
+    drawCount = AddItems(view.coins, coinTexture.get(), camera);
+    drawCount += AddItems(view.collectables, collectableTexture.get(), camera);
+    spriteBatch.Flush(renderer);
+}
+
+void ItemsDisplay::DisplayScoreLives(Renderer& renderer, int windowWidth, int windowHeight, int score, int lives,
+                                     SDL_Texture* livesIcon) {
+    /*
+     * This function displays the lives and score information in the top left of the window. These are composed onto
+     * the hudLayer texture only when the score, lives or window size change, so most frames only copy the layer. If
+     * render targets are not supported, the HUD is drawn directly every frame instead.
+     */
+    if (!hudAtlas) return;                                                                                              // textures not yet created
+
+    // resize the layer to the top left of the window
+    bool resized = (hudRect.w != windowWidth / 2 || hudRect.h != windowHeight / 10);
+    if (resized) {
+        hudRect = {0, 0, windowWidth / 2, windowHeight / 10};
+        hudLayer = assetCache->CreateRenderTarget(hudRect.w, hudRect.h);
+    }
+
+    if (!hudLayer) {
+        DrawScoreLives(renderer, windowWidth, windowHeight, score, lives, livesIcon);
+        return;
+    }
+
+    // recompose the layer
+    if (resized || score != hudScore || lives != hudLives) {
+        {
+            ScopedRenderTarget layerTarget(renderer, hudLayer.get());
+            renderer.Clear({0, 0, 0, 0});                                                                               // transparent background
+            DrawScoreLives(renderer, windowWidth, windowHeight, score, lives, livesIcon);
+        }
+
+        hudScore = score;
+        hudLives = lives;
+    }
+
+    renderer.Copy(hudLayer.get(), nullptr, hudRect);
+}
+
+void ItemsDisplay::DrawScoreLives(Renderer& renderer, int windowWidth, int windowHeight, int score, int lives,
+                                  SDL_Texture* livesIcon) {
+    /*
+     * Draws the lives and score labels, the score and the lives icons. The lives are shown through taking the player
+     * texture as a lives icon, the number of this icon indicating the amount of lives left.
+     */
+    SDL_Rect livesRect = {0, 0, windowWidth/12, windowHeight/20};
+    hudAtlas->Draw(renderer, "Lives: ", livesRect);
+
+    // DisplayTrack lives icons
+    for (int l = 0; l < lives; l++) {
+        livesRect.x += livesRect.w + livesRect.w/20;
+        livesRect.w = livesRect.h;
+
+        renderer.Copy(livesIcon, nullptr, livesRect);
+    }
+
+    // DisplayTrack score label
+    SDL_Rect scoreRect = {0, windowHeight / 20, windowWidth/12, windowHeight/20};
+    hudAtlas->Draw(renderer, "Score: ", scoreRect);
+
+    // Display score, aligned with score label and retaining w:h ratio
+    std::string scoreText = std::to_string(score);
+    int h = windowHeight/20;
+    scoreRect = {windowWidth/11, windowHeight/20, hudAtlas->MeasureWidth(scoreText, h), h};
+    hudAtlas->Draw(renderer, scoreText, scoreRect);
+}
+
+int ItemsDisplay::GetDrawCount() const {
+    return drawCount;
+}
+
+void ItemsDisplay::SetSpriteBatching(bool enabled) {
+    // Sprites are copied one at a time if disabled, for comparison
+    spriteBatch.SetBatching(enabled);
+}
+
+
+
+
+
+void PlayerDisplay::CreateTexture(AssetCache& assets) {
+    // Fetch player model Texture
+    TRACE_SCOPE("PlayerDisplay::CreateTexture", "assets");
+    playerTexture = assets.GetTexture("../Resources/Images/Player/PlayerModel.png");
+}
+
+void PlayerDisplay::Display(Renderer& renderer, double displayx, double displayy, Size2D playerSize) {
+    // This function displays the player at the provided (interpolated) rect position
+    playerRect.x = int(int(displayx) - (playerSize.w / 2.0));
+    playerRect.y = int(displayy - (playerSize.h / 2.0));
+    playerRect.w = playerSize.w;
+    playerRect.h = playerSize.h;
+
+    renderer.Copy(playerTexture.get(), nullptr, playerRect);
+}
+
+SDL_Texture* PlayerDisplay::GetTexture() const {
+    return playerTexture.get();
+}
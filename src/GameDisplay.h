@@ -0,0 +1,132 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#ifndef CPP_PROGRAMMINGPROJECT_GAMEDISPLAY_H
+#define CPP_PROGRAMMINGPROJECT_GAMEDISPLAY_H
+
+#include "GameCore.h"
+#include "AssetCache.h"
+#include "SpriteBatch.h"
+#include "Track.h"
+#include "TrackBonusItems.h"
+#include <array>
+
+/*
+ * The display of a session, drawn from the views of the track and items captured by the simulation rather than from
+ * the game objects. These hold every texture used to display the game objects and are only used on the render thread,
+ * so a session holds no textures, and can be stepped on another thread whilst the last views of it are displayed.
+ */
+
+
+
+
+
+// Displays the background, and the columns and obstacles of a TrackView
+class TrackDisplay {
+    private:
+        // SDL and display components
+        TextureHandle toplevelTexture {};
+        TextureHandle ttlBgTexture {};
+        TextureHandle trackFillerTexture {};
+        TextureHandle ttlCheckpointTexture {};
+        TextureHandle backgroundTexture {};
+        TextureHandle obstacleTexture {};
+        SDL_Rect backgroundRect {0, 0};
+        int drawCount = 0;                                                                                              // number of sprites in the last DisplayTrack
+        SpriteBatch spriteBatch {};
+        AssetCache* assetCache {};
+
+        // Columns of deco, toplevel and filler tiles composed into a strip, so each column is drawn with one copy
+        TextureHandle columnStrip {};
+        TextureHandle checkpointColumnStrip {};
+        int columnStripRows = 0;                                                                                        // rows of tiles in the strips, 0 until composed
+        Size2D columnStripTile {};                                                                                      // size of the tiles in the strips
+        bool useColumnStrips = true;
+        void ComposeColumnStrips(Renderer& renderer, int rows, Size2D tile);
+
+        // Columns of the track composed into pages a window wide, so the track of a frame is one or two copies. Pages
+        // are held in a ring, composed once each, as the camera moves onto the page before them
+        struct TerrainPage {
+            TextureHandle texture {};
+            int index = -1;                                                                                             // page of the track held, -1 if none
+        };
+        static const int TERRAIN_PAGES = 3;
+        std::array<TerrainPage, TERRAIN_PAGES> terrainPages {};
+        int pageLevel = 0;                                                                                              // TrackView::level of the pages held
+        int pageWidth = 0;
+        int pageTop = 0;                                                                                                // pages cover from here to the bottom of the window
+        int pageHeight = 0;
+        bool useTerrainPages = true;
+        static int GetPageWidth(int windowWidth, int tileWidth);
+        static TileRange GetPageRange(int page, int width, int tileWidth);
+        bool ComposeTerrainPage(Renderer& renderer, int page, const TrackView& view, const Camera& camera);
+        int AddColumns(TileRange range, double left, int top, const TrackView& view, const Camera& camera);
+
+    public:
+        static TileRange GetViewRange(double fromCameraX, double toCameraX, int windowWidth, int tileWidth);
+
+        // Display
+        void CreateTextures(AssetCache& assets);
+        void DisplayTrack(Renderer& renderer, const TrackView& view, const Camera& camera);
+        void DisplayBackground(Renderer& renderer, int windowWidth, int windowHeight);
+        int GetDrawCount() const;
+
+        // Setters
+        void SetColumnStrips(bool enabled);
+        void SetTerrainPages(bool enabled);
+        void SetSpriteBatching(bool enabled);
+};
+
+
+
+
+
+// Displays the coins and collectables of an ItemsView, and the score and lives
+class ItemsDisplay {
+    private:
+        // SDL and Display vars
+        TextureHandle coinTexture {};
+        TextureHandle collectableTexture {};
+        int drawCount = 0;                                                                                              // number of sprites in the last DisplayItems
+        SpriteBatch spriteBatch {};
+        AssetCache* assetCache {};
+        AtlasHandle hudAtlas {};                                                                                        // glyphs used for the score and lives text
+        TextureHandle hudLayer {};                                                                                      // score and lives composed together, redrawn on change
+        SDL_Rect hudRect {};
+        int hudScore = 0;
+        int hudLives = -1;
+
+        int AddItems(const std::vector<ObjectStruct>& items, SDL_Texture* texture, const Camera& camera);
+        void DrawScoreLives(Renderer& renderer, int windowWidth, int windowHeight, int score, int lives,
+                            SDL_Texture* livesIcon);
+
+    public:
+        // Display
+        void CreateTextures(AssetCache& assets);
+        void DisplayItems(Renderer& renderer, const ItemsView& view, const Camera& camera);
+        void DisplayScoreLives(Renderer& renderer, int windowWidth, int windowHeight, int score, int lives,
+                               SDL_Texture* livesIcon);
+        int GetDrawCount() const;
+
+        // Setters
+        void SetSpriteBatching(bool enabled);
+};
+
+
+
+
+
+// Displays the player model
+class PlayerDisplay {
+    private:
+        TextureHandle playerTexture {};
+        SDL_Rect playerRect {};
+
+    public:
+        void CreateTexture(AssetCache& assets);
+        void Display(Renderer& renderer, double displayx, double displayy, Size2D playerSize);
+        SDL_Texture* GetTexture() const;
+};
+
+#endif //CPP_PROGRAMMINGPROJECT_GAMEDISPLAY_H
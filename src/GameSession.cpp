@@ -0,0 +1,385 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#include "GameSession.h"
+#include "GameDisplay.h"
+#include "Profiler.h"
+#include "Log.h"
+
+GameSession::GameSession(int windowWidth, int windowHeight, unsigned int seed, bool generateInBackground,
+                         bool endlessMode) :
+        GAME_WINDOW_WIDTH(windowWidth),
+        GAME_WINDOW_HEIGHT(windowHeight),
+        MIN_TRACK_HEIGHT(windowHeight - int(2.5 * TILE_HEIGHT)),                                                        // set min and max height of track generation
+        MAX_TRACK_HEIGHT(MIN_TRACK_HEIGHT - (10 * TILE_HEIGHT)),
+        JUMPHEIGHT(6 * TILE_HEIGHT),
+        GRAVITY(JUMPHEIGHT / (2*std::pow(1500/4.0, 2))),
+        RANDOM_SEED(seed),
+        player(TILE_WIDTH, TILE_HEIGHT, MIN_TRACK_HEIGHT),
+        track(MIN_TRACK_HEIGHT, MAX_TRACK_HEIGHT, TILE_WIDTH, TILE_HEIGHT),
+        asyncGeneration(generateInBackground && !endlessMode),
+        endless(endlessMode) {
+    /*
+     * The GameSession owns all of the game objects for a single playthrough, and advances them through Step(). No SDL
+     * calls are made here (or in Step), so a session can be ran without a window for benchmarking, soak testing and
+     * bots. The front end is expected to create textures for the track and collectables whenever the level changes.
+     *
+     * Whilst a level is played, the level for the next difficulty is generated on a worker thread (unless
+     * generateInBackground is false), so that the level transition only has to swap the new level in.
+     *
+     * In endless mode there is a single track with no end, which is streamed in ahead of the camera (see
+     * Track::StartEndless). The front end is expected to create textures for newly streamed track as well.
+     *
+     * All generation draws from random streams keyed by RANDOM_SEED (see Random.h), so a seed always produces the same
+     * levels, whichever thread generates them.
+     */
+    // Set player states:
+    player.SetPlayerJumpCalcVars(JUMPHEIGHT, GRAVITY);
+
+    // CREATE FIRST LEVEL TRACK
+    if (endless) {
+        ConstructEndless();
+        return;
+    }
+    ConstructLevel(GenerateLevel(GetLevelSettings(), DIFFICULTY, LEVEL));
+    StartNextLevelGeneration();
+}
+
+
+
+
+
+double GameSession::SpeedForDifficulty(int difficulty, int tileWidth) {
+    // takes 240 gameticks to cross 1 tile, increases with difficulty
+    return (tileWidth/240.0) * (1 + difficulty*0.1);
+}
+
+LevelSettings GameSession::GetLevelSettings() const {
+    LevelSettings settings {};
+    settings.minTrackHeight = MIN_TRACK_HEIGHT;
+    settings.maxTrackHeight = MAX_TRACK_HEIGHT;
+    settings.tileWidth = TILE_WIDTH;
+    settings.tileHeight = TILE_HEIGHT;
+    settings.jumpHeight = JUMPHEIGHT;
+    settings.gravity = GRAVITY;
+    settings.seed = RANDOM_SEED;
+    return settings;
+}
+
+size_t GameSession::LevelArenaBytes(int difficulty) {
+    /*
+     * Size of the arena for a level of the difficulty: the track storage reserved by ConstructTrack, and coins for a
+     * third of the tiles (a quarter are expected) with their collision arrays. An arena grows itself if this is short.
+     */
+    LevelCapacity capacity = Track::EstimateCapacity(difficulty);
+    size_t coins = capacity.tiles / 3;
+    size_t collectables = 3;
+    size_t alignment = 8 * alignof(std::max_align_t);                                                                   // padding between the allocations
+
+    return capacity.segments * sizeof(TrackSegment) + capacity.tiles * sizeof(TileInfo)
+           + capacity.obstacles * sizeof(TrackObstacle)
+           + coins * sizeof(Coin) + collectables * sizeof(Collectable)
+           + (coins + collectables + 2 * AABBArrays::LANES) * 4 * sizeof(float) + alignment;
+}
+
+LevelData GameSession::GenerateLevel(const LevelSettings& settings, int difficulty, int level,
+                                     std::unique_ptr<Arena> arena) {
+    /*
+     * Constructs the track, coins and collectables for a level of the given difficulty. This only uses the provided
+     * settings and its own objects, so it is safe to call from a worker thread. No textures are created.
+     *
+     * The level is allocated from the provided arena, which is reset first, or from a new arena if none is given.
+     * Nothing else may still be using the arena.
+     */
+    TRACE_SCOPE_VALUE("GenerateLevel", "generation", difficulty);
+    if (!arena) arena.reset(new Arena);
+    arena->Reset(LevelArenaBytes(difficulty));
+
+    Arena* levelArena = arena.get();
+    LevelData levelData {difficulty,
+                         std::move(arena),
+                         Track {settings.minTrackHeight, settings.maxTrackHeight, settings.tileWidth,
+                                settings.tileHeight, levelArena},
+                         ScoreCollectables {levelArena}};
+
+    // Set track states, jump calc vars for the playerspeed of the difficulty
+    levelData.track.SetPlayerJumpCalcVars(settings.jumpHeight, settings.gravity,
+                                      SpeedForDifficulty(difficulty, settings.tileWidth));
+    levelData.track.SetGenerationSeed(settings.seed, level);
+    levelData.track.ConstructTrack(difficulty);
+
+    // Create collectibles
+    levelData.items.ConstructCoins(levelData.track);
+    levelData.items.ConstructSpecials(levelData.track);
+
+    return levelData;
+}
+
+void GameSession::StartNextLevelGeneration() {
+    // Begin generating the level for the next difficulty on a worker thread
+    if (!asyncGeneration) return;
+
+    LevelSettings settings = GetLevelSettings();
+    int difficulty = GetNextDifficulty();
+    int level = LEVEL + 1;
+    nextLevel = std::async(std::launch::async, [settings, difficulty, level, arena = std::move(spareArena)]() mutable {
+        TRACE_THREAD_NAME("level generation");
+        return GenerateLevel(settings, difficulty, level, std::move(arena));
+    });
+}
+
+void GameSession::NextLevel() {
+    /*
+     * Moves the session onto the next level. Increases the difficulty, resets the player and swaps in the pre-generated
+     * level, only waiting on the worker thread if it has not yet finished. Generation of the following level is then
+     * started.
+     */
+    TRACE_SCOPE_VALUE("level transition", "level", GetNextDifficulty());
+
+    // Increase Difficulty (max 6)
+    DIFFICULTY = GetNextDifficulty();
+    LEVEL++;
+
+    // Reset player position, elapsed time
+    player.ResetPlayerPosition(MIN_TRACK_HEIGHT);
+    ELAPSED_TIME = 0;
+
+    // Swap in the new level
+    if (nextLevel.valid()) {
+        ConstructLevel(nextLevel.get());
+    } else {
+        ConstructLevel(GenerateLevel(GetLevelSettings(), DIFFICULTY, LEVEL, std::move(spareArena)));
+    }
+
+    StartNextLevelGeneration();
+}
+
+bool GameSession::NextLevelReady() const {
+    return !nextLevel.valid() || nextLevel.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+void GameSession::ConstructLevel(LevelData level) {
+    // Set player speed for the difficulty
+    player.SetPlayerSpeed(SpeedForDifficulty(level.difficulty, TILE_WIDTH));
+
+    // Replace the track and collectibles
+    track = std::move(level.track);
+    collectables.TakeItems(level.items);
+
+    LOG_INFO("LEVEL ARENA | difficulty %d: %.1f KB of %.1f KB used, %zu bytes overflowed", level.difficulty,
+             level.arena->GetPeak() / 1024.0, level.arena->GetCapacity() / 1024.0, level.arena->GetOverflowBytes());
+
+    // the previous level's storage has now been released, so its arena is kept to generate a later level in
+    spareArena = std::move(levelArena);
+    levelArena = std::move(level.arena);
+
+    endOfTrackScoreAdded = false;
+    endOfTrackLivesAdded = false;
+    levelChanged = true;
+    levelsConstructed++;
+
+    // Set player display position for the new track, no interpolation across the level change
+    player.UpdateRectPosition(track, ELAPSED_TIME);
+    prevState = currState = CaptureRenderState();
+}
+
+void GameSession::ConstructEndless() {
+    // Player speed stays at that of the starting difficulty, only the track generation gets harder
+    player.SetPlayerSpeed(SpeedForDifficulty(DIFFICULTY, TILE_WIDTH));
+    track.SetPlayerJumpCalcVars(JUMPHEIGHT, GRAVITY, SpeedForDifficulty(DIFFICULTY, TILE_WIDTH));
+    track.SetGenerationSeed(RANDOM_SEED, LEVEL);
+    track.StartEndless(DIFFICULTY);
+    StreamTrack();
+
+    levelChanged = true;
+    levelsConstructed++;
+    player.UpdateRectPosition(track, ELAPSED_TIME);
+    prevState = currState = CaptureRenderState();
+}
+
+void GameSession::StreamTrack() {
+    // Generate the track (and coins) ahead of the camera, if the camera has moved far enough
+    PROFILE_SCOPE(PROFILE_STREAMING);
+    Camera camera {currState.cameraX, GAME_WINDOW_WIDTH, GAME_WINDOW_HEIGHT};
+    TileRange added = track.StreamAhead(camera);
+    if (added.first > added.last) return;
+
+    collectables.StreamCoins(track, added);
+}
+
+RenderState GameSession::CaptureRenderState() {
+    RenderState state;
+    state.cameraX = double(ELAPSED_TIME) * player.GetPlayerSpeed().x;
+    Vector2D rectPosition = player.GetRectPosition();
+    state.playerx = rectPosition.x;
+    state.playery = rectPosition.y;
+    return state;
+}
+
+
+
+
+
+void GameSession::Step(const SessionInputs& inputs, Uint64 tickchange) {
+    /*
+     * Advances the game by tickchange milliseconds using the provided inputs. This replaces the update section of the
+     * GameLoop, and covers the player movement, collectable pickups, obstacle collision, score over time, and the end
+     * of level handling and new level generation. The front end should always step by SIM_TICK so that the physics
+     * and jump arcs are the same regardless of frame rate.
+     */
+    if (GameOver()) return;
+    prevState = currState;
+
+    // apply inputs
+    if (inputs.pausePressed) paused = true;                                                                             // pause the game
+    if (inputs.resumePressed) paused = false;                                                                           // unpause the game
+    player.Jump(inputs.jumpHeld);                                                                                       // player jump management
+
+    // update deltaTick vars
+    if (paused) tickchange = 0;                                                                                         // prevent player and track positions from changing
+    ELAPSED_TIME += tickchange;
+    scoreTick += tickchange;
+
+    // MAIN GAMEPLAY HANDLING
+    bool voidedOut = false;
+    if (!player.AtEndOfTrack(track)) {
+        // update player
+        {
+            PROFILE_SCOPE(PROFILE_MOVEMENT);
+            player.MovementUpdate(track, tickchange, ELAPSED_TIME);
+            voidedOut = player.CheckVoidOut(GAME_WINDOW_HEIGHT, ELAPSED_TIME);
+        }
+
+        // Update collectables
+        ObjectStruct playerStruct = player.GetCollisionStruct();
+        {
+            PROFILE_SCOPE(PROFILE_PICKUPS);
+            collectables.UpdateCoins(playerStruct);
+            collectables.UpdateSpecials(playerStruct);
+        }
+
+        // Check for obstacle collision:
+        {
+            PROFILE_SCOPE(PROFILE_COLLISION);
+            if (track.CheckForCollision(playerStruct)) {
+                player.ForceVoidOut();
+            }
+        }
+
+        // apply score over time
+        if (scoreTick >= 50) {
+            collectables.AddScore(5);
+            scoreTick = (scoreTick > 50) ? scoreTick - 50 : 0;
+        }
+    }
+
+    // END OF LEVEL HANDLING : ENDING MOVEMENT + SCORE + LIVES
+    if (player.OnScreen(0, GAME_WINDOW_WIDTH) && player.AtEndOfTrack(track)) {
+        // Award score for completing level
+        if (!endOfTrackScoreAdded) {
+            collectables.AddScore(3000);
+            endOfTrackScoreAdded = true;
+        }
+
+        // Check if player has collected all 3 collectables
+        if (collectables.CollectablesObtained() && !endOfTrackLivesAdded) {
+            player.AddPlayerLives(1);
+            endOfTrackLivesAdded = true;
+        }
+    }
+
+    // END OF LEVEL HANDLING : NEW LEVEL
+    if (!endless && !player.OnScreen(0, GAME_WINDOW_WIDTH)) {
+        NextLevel();
+        return;
+    }
+
+    // Update player display position
+    player.UpdateRectPosition(track, ELAPSED_TIME);
+    currState = CaptureRenderState();
+    if (voidedOut) prevState = currState;                                                                               // player is teleported to checkpoint so dont interpolate
+
+    if (endless) StreamTrack();
+}
+
+RenderState GameSession::GetRenderState(double alpha) const {
+    /*
+     * Returns the display state interpolated between the previous and current steps, where alpha is the fraction of a
+     * SIM_TICK of wall time that has not yet been simulated.
+     */
+    RenderState state;
+    state.cameraX = prevState.cameraX + (currState.cameraX - prevState.cameraX) * alpha;
+    state.playerx = prevState.playerx + (currState.playerx - prevState.playerx) * alpha;
+    state.playery = prevState.playery + (currState.playery - prevState.playery) * alpha;
+    return state;
+}
+
+bool GameSession::GameOver() const {
+    return player.GetLives() < 0;
+}
+
+bool GameSession::ConsumeLevelChanged() {
+    // Returns true once after each new level is constructed
+    bool changed = levelChanged;
+    levelChanged = false;
+    return changed;
+}
+
+void GameSession::CaptureViews(TrackView& trackView, ItemsView& itemsView) {
+    /*
+     * Copies the parts of the track and items that can be displayed until the next step into the views, which are
+     * those around the camera anywhere from its position before the last step to its position after it. The track view
+     * also holds the tiles of the terrain pages composed whilst the camera is there.
+     */
+    double fromx = std::min(prevState.cameraX, currState.cameraX);
+    double tox = std::max(prevState.cameraX, currState.cameraX);
+
+    track.CaptureView(trackView, TrackDisplay::GetViewRange(fromx, tox, GAME_WINDOW_WIDTH, TILE_WIDTH));
+    trackView.level = levelsConstructed;
+    collectables.CaptureView(itemsView, fromx, tox + GAME_WINDOW_WIDTH);
+}
+
+
+
+
+
+Player& GameSession::GetPlayer() {
+    return player;
+}
+
+Track& GameSession::GetTrack() {
+    return track;
+}
+
+ScoreCollectables& GameSession::GetCollectables() {
+    return collectables;
+}
+
+Uint64 GameSession::GetElapsedTime() const {
+    return ELAPSED_TIME;
+}
+
+unsigned int GameSession::GetSeed() const {
+    return RANDOM_SEED;
+}
+
+int GameSession::GetDifficulty() const {
+    return DIFFICULTY;
+}
+
+int GameSession::GetNextDifficulty() const {
+    return (DIFFICULTY < 6) ? DIFFICULTY + 1 : 6;
+}
+
+int GameSession::GetLevelsConstructed() const {
+    return levelsConstructed;
+}
+
+bool GameSession::IsPaused() const {
+    return paused;
+}
+
+bool GameSession::IsEndless() const {
+    return endless;
+}
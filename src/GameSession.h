@@ -0,0 +1,142 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#ifndef CPP_PROGRAMMINGPROJECT_GAMESESSION_H
+#define CPP_PROGRAMMINGPROJECT_GAMESESSION_H
+
+#include "GameCore.h"
+#include "Track.h"
+#include "Player.h"
+#include "TrackBonusItems.h"
+#include <future>
+
+
+
+
+
+struct SessionInputs {
+    bool jumpHeld = false;                                                                                              // jump key is currently held down
+    bool pausePressed = false;                                                                                          // request to pause the game
+    bool resumePressed = false;                                                                                         // request to unpause the game
+};
+
+// Values needed to generate a level, copied so generation can run on a worker thread
+struct LevelSettings {
+    int minTrackHeight, maxTrackHeight;
+    int tileWidth, tileHeight;
+    int jumpHeight;
+    double gravity;
+    unsigned int seed;                                                                                                  // session seed, levels generate from their own streams of it
+};
+
+// A generated level, ready to be swapped into the session
+struct LevelData {
+    int difficulty;
+    std::unique_ptr<Arena> arena;                                                                                       // storage of the track and items, declared first to outlive them
+    Track track;
+    ScoreCollectables items;                                                                                            // only the coins and collectables are used
+};
+
+struct RenderState {
+    double cameraX = 0;                                                                                                 // distance the track and items have scrolled by
+    double playerx = 0, playery = 0;                                                                                    // player rect position
+};
+
+
+
+
+
+class GameSession {
+    private:
+        // "global" vars that manage the game
+        int GAME_WINDOW_WIDTH, GAME_WINDOW_HEIGHT;
+        int TILE_WIDTH = 48;
+        int TILE_HEIGHT = 48;
+        int MIN_TRACK_HEIGHT, MAX_TRACK_HEIGHT;
+        int DIFFICULTY = 0;
+        int LEVEL = 0;                                                                                                  // levels completed, keys the generation streams
+        int levelsConstructed = 0;                                                                                      // tracks swapped in, including the first
+        int JUMPHEIGHT;
+        double GRAVITY;
+        unsigned int RANDOM_SEED;
+
+        // arena holding the current level's track and items, and the previous level's arena which is reused to generate
+        // the next. Declared before the game objects so that it outlives them
+        std::unique_ptr<Arena> levelArena {};
+        std::unique_ptr<Arena> spareArena {};
+
+        // game objects
+        Player player;
+        Track track;
+        ScoreCollectables collectables {};
+
+        // end of level adding score/lives management
+        bool endOfTrackScoreAdded = false;
+        bool endOfTrackLivesAdded = false;
+        bool levelChanged = false;
+
+        // deltaTicks vars
+        Uint64 scoreTick = 0;                                                                                           // for determining when player recieves score over time
+        Uint64 ELAPSED_TIME = 0;                                                                                        // elapsed time of the current level
+
+        // game pausing control
+        bool paused = false;
+
+        // next level, generated in the background whilst the current level is played
+        bool asyncGeneration;
+        std::future<LevelData> nextLevel {};
+
+        // endless mode, a single track streamed in as the player moves
+        bool endless;
+
+        // states at the start and end of the last step, interpolated between for rendering
+        RenderState prevState {};
+        RenderState currState {};
+
+        LevelSettings GetLevelSettings() const;
+        void StartNextLevelGeneration();
+        void ConstructLevel(LevelData level);
+        void ConstructEndless();
+        void StreamTrack();
+        RenderState CaptureRenderState();
+
+    public:
+        static const Uint64 SIM_TICK = 1;                                                                               // fixed length of a simulation step in ms
+        static const Uint64 MAX_FRAME_TIME = 250;                                                                       // max wall time simulated per frame after a hitch
+
+        GameSession(int windowWidth, int windowHeight, unsigned int seed, bool generateInBackground = true,
+                    bool endlessMode = false);
+
+        // Level generation
+        static double SpeedForDifficulty(int difficulty, int tileWidth);
+        static size_t LevelArenaBytes(int difficulty);
+        static LevelData GenerateLevel(const LevelSettings& settings, int difficulty, int level,
+                                       std::unique_ptr<Arena> arena = nullptr);
+        void NextLevel();
+        bool NextLevelReady() const;
+
+        // Simulation
+        void Step(const SessionInputs& inputs, Uint64 tickchange = SIM_TICK);
+        bool GameOver() const;
+        bool ConsumeLevelChanged();
+        RenderState GetRenderState(double alpha) const;
+
+        // Display
+        void CaptureViews(TrackView& trackView, ItemsView& itemsView);
+
+        // Getters
+        Player& GetPlayer();
+        Track& GetTrack();
+        ScoreCollectables& GetCollectables();
+        Uint64 GetElapsedTime() const;
+        unsigned int GetSeed() const;
+        int GetDifficulty() const;
+        int GetNextDifficulty() const;
+        int GetLevelsConstructed() const;
+        bool IsPaused() const;
+        bool IsEndless() const;
+};
+
+
+#endif //CPP_PROGRAMMINGPROJECT_GAMESESSION_H
@@ -0,0 +1,225 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#include "GenerationProfiles.h"
+#include <cerrno>
+#include <limits>
+#include <sstream>
+
+// Compiled in copy of RequiredFiles/GenerationPercs.txt, as {min%, max%, minLen, maxLen} for each section type
+static constexpr int BUILTIN_PERCS[GenerationProfiles::MAX_DIFFICULTY + 1][SECTION_TYPES][4] = {
+        //   long          medium         short          single          jump            obstacle
+        {{0, 60, 7, 9}, {60, 90, 4, 6}, {90, 100, 2, 3}, {0, 0, 1, 1},   {0, 10, 2, 4},  {0, 3, 0, 8}},
+        {{0, 45, 7, 9}, {45, 80, 4, 6}, {80, 100, 2, 3}, {0, 0, 1, 1},   {0, 20, 2, 6},  {0, 4, 0, 8}},
+        {{0, 25, 7, 9}, {25, 55, 4, 6}, {55, 85, 2, 3},  {85, 100, 1, 1}, {0, 40, 3, 8},  {0, 4, 0, 10}},
+        {{0, 25, 7, 9}, {25, 50, 4, 6}, {50, 75, 2, 3},  {75, 100, 1, 1}, {0, 60, 3, 14}, {0, 5, 0, 10}},
+        {{0, 10, 7, 9}, {10, 30, 4, 6}, {30, 60, 2, 3},  {60, 100, 1, 1}, {0, 80, 2, 14}, {0, 5, 0, 15}},
+        {{0, 0, 7, 9},  {0, 15, 4, 6},  {15, 60, 2, 3},  {60, 100, 1, 1}, {0, 100, 5, 14}, {0, 6, 0, 15}},
+        {{0, 0, 7, 9},  {0, 0, 4, 6},   {0, 30, 2, 3},   {30, 100, 1, 1}, {0, 100, 5, 14}, {0, 0, 0, 5}},
+};
+
+static std::string Trim(const std::string& str) {
+    size_t first = str.find_first_not_of(" \t\r");
+    if (first == std::string::npos) return "";
+    return str.substr(first, str.find_last_not_of(" \t\r") - first + 1);
+}
+
+static bool ParseInt(const std::string& str, int& value) {
+    // strict conversion, the whole string must be an integer
+    if (str.empty()) return false;
+    char* end = nullptr;
+    errno = 0;
+    long parsed = std::strtol(str.c_str(), &end, 10);
+    if (*end != '\0' || errno == ERANGE) return false;
+    if (parsed < std::numeric_limits<int>::min() || parsed > std::numeric_limits<int>::max()) return false;
+    value = int(parsed);
+    return true;
+}
+
+
+
+
+
+bool GenerationProfiles::ParseRow(const std::string& line, GenerationProfile& profile, std::string& error) {
+    /*
+     * Parses a row of the form "difficulty, min%:max%:minLen:maxLen:, ... , end" with an entry for each section type.
+     * Returns false with a description of the problem in error if the row is malformed.
+     */
+    std::vector<std::string> fields {};
+    std::stringstream lineStream(line);
+    std::string field;
+    while (std::getline(lineStream, field, ',')) fields.push_back(Trim(field));
+
+    if (fields.size() != SECTION_TYPES + 2 || fields.back() != "end") {
+        error = "expected a difficulty, " + std::to_string(SECTION_TYPES) + " sections and \"end\"";
+        return false;
+    }
+    if (!ParseInt(fields[0], profile.difficulty)) {
+        error = "difficulty \"" + fields[0] + "\" is not a number";
+        return false;
+    }
+
+    for (int s = 0; s < SECTION_TYPES; s++) {
+        std::string sectionField = fields[s + 1];
+        if (!sectionField.empty() && sectionField.back() == ':') sectionField.pop_back();                              // trailing ':' is optional
+
+        std::vector<std::string> values {};
+        std::stringstream sectionStream(sectionField);
+        while (std::getline(sectionStream, field, ':')) values.push_back(Trim(field));
+
+        int parsed[4] = {};
+        bool valid = values.size() == 4;
+        for (int v = 0; valid && v < 4; v++) valid = ParseInt(values[v], parsed[v]);
+        if (!valid) {
+            error = "section " + std::to_string(s + 1) + " \"" + fields[s + 1] + "\" is not min%:max%:minLen:maxLen";
+            return false;
+        }
+
+        profile.sections[s].Construct(parsed[0], parsed[1], parsed[2], parsed[3]);
+    }
+
+    return Validate(profile, error);
+}
+
+bool GenerationProfiles::Validate(GenerationProfile& profile, std::string& error) {
+    /*
+     * Checks the rates and lengths of a profile are usable, and builds its sectionForRoll table. Every roll from 0-99
+     * must pick exactly one of the track section types.
+     */
+    if (profile.difficulty < 0 || profile.difficulty > MAX_DIFFICULTY) {
+        error = "difficulty " + std::to_string(profile.difficulty) + " is not 0-" + std::to_string(MAX_DIFFICULTY);
+        return false;
+    }
+
+    for (int s = 0; s < SECTION_TYPES; s++) {
+        const SectionInfo& section = profile.sections[s];
+        int minLength = (s == SECTION_OBSTACLE) ? 0 : 1;                                                                // obstacle lengths are unused
+
+        if (section.minGenBound < 0 || section.minGenBound > section.maxGenBound || section.maxGenBound > 100) {
+            error = "section " + std::to_string(s + 1) + " rates are not 0 <= min% <= max% <= 100";
+            return false;
+        }
+        if (section.minLen < minLength || section.minLen > section.maxLen) {
+            error = "section " + std::to_string(s + 1) + " lengths are not " + std::to_string(minLength)
+                    + " <= minLen <= maxLen";
+            return false;
+        }
+    }
+
+    for (int roll = 0; roll < 100; roll++) {
+        profile.sectionForRoll[roll] = -1;
+        for (int s = SECTION_LONG; s <= SECTION_SINGLE; s++) {
+            if (!profile.sections[s].WithinGenBounds(roll)) continue;
+            if (profile.sectionForRoll[roll] != -1) {
+                error = "roll " + std::to_string(roll) + " is within the rates of more than one track section";
+                return false;
+            }
+            profile.sectionForRoll[roll] = (signed char)s;
+        }
+
+        if (profile.sectionForRoll[roll] == -1) {
+            error = "roll " + std::to_string(roll) + " is not within the rates of any track section";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+GenerationProfiles GenerationProfiles::LoadFile(const std::string& path, std::string& error) {
+    /*
+     * Reads and validates a profile for every difficulty from the file at path. Lines that are empty or begin with '#'
+     * or a space are comments, as the file's header describes. If the file cannot be read, or any row is malformed or
+     * missing, no profiles are returned and error describes the problem.
+     */
+    GenerationProfiles loaded;
+    loaded.profiles.resize(MAX_DIFFICULTY + 1);
+    std::vector<bool> found (MAX_DIFFICULTY + 1, false);
+
+    std::ifstream profileFile(path);
+    if (!profileFile.is_open()) {
+        error = "could not open " + path;
+        return {};
+    }
+
+    std::string line;
+    for (int lineNumber = 1; std::getline(profileFile, line); lineNumber++) {
+        if (line.empty() || line[0] == '#' || line[0] == ' ') continue;
+        line = Trim(line);
+        if (line.empty()) continue;
+
+        GenerationProfile profile {};
+        std::string rowError;
+        if (!ParseRow(line, profile, rowError)) {
+            error = path + " line " + std::to_string(lineNumber) + ": " + rowError;
+            return {};
+        }
+        if (found[profile.difficulty]) {
+            error = path + " line " + std::to_string(lineNumber) + ": difficulty "
+                    + std::to_string(profile.difficulty) + " is repeated";
+            return {};
+        }
+
+        loaded.profiles[profile.difficulty] = profile;
+        found[profile.difficulty] = true;
+    }
+
+    for (int d = 0; d <= MAX_DIFFICULTY; d++) {
+        if (found[d]) continue;
+        error = path + ": no row for difficulty " + std::to_string(d);
+        return {};
+    }
+
+    return loaded;
+}
+
+GenerationProfiles GenerationProfiles::BuiltIn() {
+    // Profiles from the compiled in table
+    GenerationProfiles builtIn;
+    for (int d = 0; d <= MAX_DIFFICULTY; d++) {
+        GenerationProfile profile {};
+        profile.difficulty = d;
+        for (int s = 0; s < SECTION_TYPES; s++) {
+            const int* rates = BUILTIN_PERCS[d][s];
+            profile.sections[s].Construct(rates[0], rates[1], rates[2], rates[3]);
+        }
+
+        std::string error;
+        if (!Validate(profile, error)) printf("GENERATION PROFILES | BUILT IN DIFFICULTY %d: %s\n", d, error.c_str());
+        builtIn.profiles.push_back(profile);
+    }
+    return builtIn;
+}
+
+const GenerationProfiles& GenerationProfiles::Get() {
+    /*
+     * Returns the profiles used for track generation, which are loaded from GenerationPercs.txt on first use (this is
+     * thread safe, so is fine from a level generation thread). If the file is missing or malformed, the error is
+     * printed and the compiled in profiles are used instead. Building with BUILTIN_GENERATION_PROFILES defined skips
+     * reading the file.
+     */
+    static const GenerationProfiles loaded = [] {
+#ifdef BUILTIN_GENERATION_PROFILES
+        return BuiltIn();
+#else
+        std::string error;
+        GenerationProfiles fromFile = LoadFile("../RequiredFiles/GenerationPercs.txt", error);
+        if (!fromFile.Empty()) return fromFile;
+
+        printf("GENERATION PROFILES | ERROR: %s. Using built in profiles\n", error.c_str());
+        return BuiltIn();
+#endif
+    }();
+    return loaded;
+}
+
+bool GenerationProfiles::Empty() const {
+    return profiles.empty();
+}
+
+const GenerationProfile& GenerationProfiles::ForDifficulty(int difficulty) const {
+    // difficulties beyond those with a profile use the closest profile
+    difficulty = std::max(0, std::min(difficulty, int(profiles.size()) - 1));
+    return profiles[difficulty];
+}
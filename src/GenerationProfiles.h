@@ -0,0 +1,70 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#ifndef CPP_PROGRAMMINGPROJECT_GENERATIONPROFILES_H
+#define CPP_PROGRAMMINGPROJECT_GENERATIONPROFILES_H
+
+#include "GameCore.h"
+#include <array>
+
+struct SectionInfo {
+    int minGenBound;
+    int maxGenBound;
+    int minLen;
+    int maxLen;
+
+    void Construct(int minGB, int maxGB, int minL, int maxL) {
+        minGenBound = minGB;
+        maxGenBound = maxGB;
+        minLen = minL;
+        maxLen = maxL;
+    }
+
+    bool WithinGenBounds(int rGenValue) const {
+        return (minGenBound <= rGenValue && rGenValue < maxGenBound);
+    }
+};
+
+// Order of the sections within a row of GenerationPercs.txt
+enum SectionType {
+    SECTION_LONG, SECTION_MEDIUM, SECTION_SHORT, SECTION_SINGLE,                                                        // track sections, picked by a roll
+    SECTION_JUMP, SECTION_OBSTACLE,                                                                                     // chance of a jump / obstacle
+    SECTION_TYPES
+};
+
+// Generation rates for a single difficulty
+struct GenerationProfile {
+    int difficulty = 0;
+    std::array<SectionInfo, SECTION_TYPES> sections {};
+    std::array<signed char, 100> sectionForRoll {};                                                                    // track section type picked by each roll, -1 if none
+
+    int SectionForRoll(int roll) const {
+        return sectionForRoll[roll];
+    }
+};
+
+
+
+
+
+class GenerationProfiles {
+    private:
+        std::vector<GenerationProfile> profiles {};                                                                     // indexed by difficulty
+
+        static bool ParseRow(const std::string& line, GenerationProfile& profile, std::string& error);
+        static bool Validate(GenerationProfile& profile, std::string& error);
+
+    public:
+        static const int MAX_DIFFICULTY = 6;
+
+        static GenerationProfiles LoadFile(const std::string& path, std::string& error);
+        static GenerationProfiles BuiltIn();
+        static const GenerationProfiles& Get();
+
+        bool Empty() const;
+        const GenerationProfile& ForDifficulty(int difficulty) const;
+};
+
+
+#endif //CPP_PROGRAMMINGPROJECT_GENERATIONPROFILES_H
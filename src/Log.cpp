@@ -0,0 +1,164 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#include "Log.h"
+#include <cstdarg>
+#include <cstring>
+
+Logger::Logger() {
+    writer = std::thread(&Logger::WriterLoop, this);
+}
+
+Logger::~Logger() {
+    // The writer drains any remaining messages before it stops
+    running = false;
+    if (writer.joinable()) writer.join();
+}
+
+Logger& Logger::Get() {
+    static Logger logger;
+    return logger;
+}
+
+const char* Logger::LevelName(LogLevel level) {
+    static const char* names[] = {"DEBUG", "INFO", "WARN", "ERROR"};
+    return names[level];
+}
+
+Logger::ThreadRing::~ThreadRing() {
+    // the writer frees the ring once it has been drained
+    if (ring) ring->closed.store(true, std::memory_order_release);
+}
+
+Logger::Ring& Logger::GetThreadRing() {
+    // Each thread's ring is created the first time it logs
+    thread_local ThreadRing threadRing;
+    if (threadRing.ring) return *threadRing.ring;
+
+    std::unique_ptr<Ring> ring (new Ring);
+    threadRing.ring = ring.get();
+    std::lock_guard<std::mutex> lock(ringsMutex);
+    rings.push_back(std::move(ring));
+    return *threadRing.ring;
+}
+
+
+
+
+
+void Logger::Write(LogLevel level, const char* format, ...) {
+    /*
+     * Formats the message into the next free message of the calling thread's ring. This never waits on the writer
+     * thread or on stdout, if the ring is full the message is dropped instead.
+     */
+    Ring& ring = GetThreadRing();
+    size_t head = ring.head.load(std::memory_order_relaxed);
+    if (head - ring.tail.load(std::memory_order_acquire) >= RING_MESSAGES) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Message& message = ring.messages[head % RING_MESSAGES];
+    message.level = level;
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message.text, MESSAGE_BYTES, format, args);
+    va_end(args);
+
+    ring.head.store(head + 1, std::memory_order_release);                                                               // publish the message to the writer
+}
+
+bool Logger::Drain(std::vector<char>& output) {
+    /*
+     * Writes every message waiting in the rings to stdout, returning false if there were none. The lock is only held
+     * to read the list of rings and to free drained ones, never whilst writing, so a thread logging for the first time
+     * does not wait on stdout. Rings are only freed here, so those read stay valid once the lock is released.
+     */
+    {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        drainRings.clear();
+        drainHeads.clear();
+        for (const std::unique_ptr<Ring>& ring : rings) {
+            drainRings.push_back(ring.get());
+            drainHeads.push_back(ring->head.load(std::memory_order_acquire));
+        }
+    }
+
+    output.clear();
+    for (size_t r = 0; r < drainRings.size(); r++) {
+        const Ring& ring = *drainRings[r];
+        for (size_t m = ring.tail.load(std::memory_order_relaxed); m < drainHeads[r]; m++) {
+            const Message& message = ring.messages[m % RING_MESSAGES];
+            char prefix[16];
+            int prefixLength = snprintf(prefix, sizeof(prefix), "[%s] ", LevelName(message.level));
+            output.insert(output.end(), prefix, prefix + prefixLength);
+            output.insert(output.end(), message.text, message.text + strlen(message.text));
+            output.push_back('\n');
+        }
+    }
+
+    Uint64 droppedNow = dropped.load(std::memory_order_relaxed);
+    if (droppedNow != droppedReported) {
+        char report[64];
+        int length = snprintf(report, sizeof(report), "[WARN] LOG | %llu messages dropped\n",
+                              (unsigned long long)(droppedNow - droppedReported));
+        output.insert(output.end(), report, report + length);
+        droppedReported = droppedNow;
+    }
+
+    if (!output.empty()) {
+        fwrite(output.data(), 1, output.size(), stdout);
+        fflush(stdout);
+    }
+
+    // the messages are only released once written, so Flush can wait on the rings being empty
+    bool anyClosed = false;
+    for (size_t r = 0; r < drainRings.size(); r++) {
+        drainRings[r]->tail.store(drainHeads[r], std::memory_order_release);
+        anyClosed = anyClosed || drainRings[r]->closed.load(std::memory_order_acquire);
+    }
+
+    // free the rings of threads that have exited, once drained
+    if (anyClosed) {
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        rings.erase(std::remove_if(rings.begin(), rings.end(), [](const std::unique_ptr<Ring>& ring) {
+            return ring->closed.load(std::memory_order_acquire)
+                   && ring->tail.load(std::memory_order_relaxed) == ring->head.load(std::memory_order_acquire);
+        }), rings.end());
+    }
+
+    return !output.empty();
+}
+
+void Logger::WriterLoop() {
+    std::vector<char> output {};
+    output.reserve(RING_MESSAGES * MESSAGE_BYTES);
+
+    while (running) {
+        if (!Drain(output)) std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    Drain(output);
+}
+
+
+
+
+
+void Logger::Flush() {
+    // Waits until every message logged so far has been written, for use before printing results
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(ringsMutex);
+            bool empty = std::all_of(rings.begin(), rings.end(), [](const std::unique_ptr<Ring>& ring) {
+                return ring->tail.load(std::memory_order_acquire) == ring->head.load(std::memory_order_acquire);
+            });
+            if (empty) return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+Uint64 Logger::GetDroppedCount() const {
+    return dropped.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,88 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#ifndef CPP_PROGRAMMINGPROJECT_LOG_H
+#define CPP_PROGRAMMINGPROJECT_LOG_H
+
+#include "GameCore.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+enum LogLevel {
+    LOG_LEVEL_DEBUG,
+    LOG_LEVEL_INFO,
+    LOG_LEVEL_WARN,
+    LOG_LEVEL_ERROR,
+};
+
+/*
+ * Leveled logger which never writes to stdout on the calling thread. Each thread that logs is given its own single
+ * producer, single consumer ring of fixed size messages, which the message is formatted directly into. A background
+ * thread drains the rings and writes them to stdout. If a ring is full the message is dropped and counted, rather than
+ * blocking the caller, and the number dropped is reported once the rings have room again.
+ */
+class Logger {
+    public:
+        static const size_t RING_MESSAGES = 512;
+        static const size_t MESSAGE_BYTES = 160;                                                                        // longer messages are truncated
+
+    private:
+        struct Message {
+            LogLevel level;
+            char text[MESSAGE_BYTES];
+        };
+
+        struct Ring {
+            std::array<Message, RING_MESSAGES> messages {};
+            std::atomic<size_t> head {0};                                                                               // next message to write, owned by the producer
+            char padding[64] {};                                                                                        // keeps head and tail on separate cache lines
+            std::atomic<size_t> tail {0};                                                                               // next message to read, owned by the writer
+            std::atomic<bool> closed {false};                                                                           // producer thread has exited
+        };
+
+        // closes the ring of a thread when the thread exits
+        struct ThreadRing {
+            Ring* ring = nullptr;
+            ~ThreadRing();
+        };
+
+        std::mutex ringsMutex {};
+        std::vector<std::unique_ptr<Ring>> rings {};
+        std::vector<Ring*> drainRings {};                                                                               // rings and heads being drained, owned by the writer
+        std::vector<size_t> drainHeads {};
+        std::atomic<Uint64> dropped {0};
+        Uint64 droppedReported = 0;
+        std::atomic<bool> running {true};
+        std::thread writer {};
+
+        Logger();
+        Ring& GetThreadRing();
+        bool Drain(std::vector<char>& output);
+        void WriterLoop();
+
+    public:
+        ~Logger();
+
+        static Logger& Get();
+        static const char* LevelName(LogLevel level);
+
+        void Write(LogLevel level, const char* format, ...);
+        void Flush();
+        Uint64 GetDroppedCount() const;
+};
+
+// Debug messages are only compiled in when built with ENABLE_DEBUG_LOGGING, their arguments are not evaluated otherwise
+#ifdef ENABLE_DEBUG_LOGGING
+#define LOG_DEBUG(...) Logger::Get().Write(LOG_LEVEL_DEBUG, __VA_ARGS__)
+#else
+#define LOG_DEBUG(...) (true ? (void)0 : Logger::Get().Write(LOG_LEVEL_DEBUG, __VA_ARGS__))
+#endif
+
+#define LOG_INFO(...) Logger::Get().Write(LOG_LEVEL_INFO, __VA_ARGS__)
+#define LOG_WARN(...) Logger::Get().Write(LOG_LEVEL_WARN, __VA_ARGS__)
+#define LOG_ERROR(...) Logger::Get().Write(LOG_LEVEL_ERROR, __VA_ARGS__)
+
+#endif //CPP_PROGRAMMINGPROJECT_LOG_H
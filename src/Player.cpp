@@ -3,6 +3,7 @@
 //
 
 #include "Player.h"
+#include "Log.h"
 
 Player::Player(int w, int h, int MIN_TRACK_HEIGHT){
     // Set width, height
@@ -23,9 +24,6 @@ Player::Player(int w, int h, int MIN_TRACK_HEIGHT){
 
     // Set speed values
     speedx = width / 240.0, speedy = 0;
-
-    // Initialise rect
-    playerRect = {0, 0, width, height};
 }
 
 
@@ -50,7 +48,7 @@ void Player::MovementUpdate(Track &track, Uint64 tickchange, Uint64 ELAPSED_TIME
 
     // Increment game position
     gamex = speedx * double(ELAPSED_TIME) + offsetx;
-    gamey = (0.5 * gravity * std::pow(timeSinceOnTrack, 2)) - (speedy * timeSinceOnTrack) + offsety;               // produced quadratic curve (from t^2) to model player height
+    gamey = (0.5 * gravity * std::pow(timeSinceOnTrack, 2)) - (speedy * timeSinceOnTrack) + offsety;                    // produced quadratic curve (from t^2) to model player height
 }
 
 
@@ -58,32 +56,34 @@ void Player::MovementUpdate(Track &track, Uint64 tickchange, Uint64 ELAPSED_TIME
 
 
 
-bool Player::WithinTrackBounds(Track track) {
+bool Player::WithinTrackBounds(const Track& track) {
     /*
      * This function determines if the player is within the x boundaries of a track segment, that is either behind it,
      * under it or infront of it. If the bottom of the player is within 5 distance from the top of the track, and is
      * falling, then the player will be deemed to be within the bounds.
      */
-    int trackIndex = int(gamex/track.GetTrackWidthHeight()[0]);
-    std::vector<TrackSegment> checkTracks = {track.GetTrackAtIndex(trackIndex - 1),                            // get previous, current and next track to check for player collision
-                                             track.GetTrackAtIndex(trackIndex),
-                                             track.GetTrackAtIndex(trackIndex + 1)};
+    int trackIndex = int(gamex/track.GetTrackWidthHeight().w);
+    const TrackSegment* checkTracks[3] = {&track.GetTrackAtIndex(trackIndex - 1),                                       // get previous, current and next track to check for player collision
+                                          &track.GetTrackAtIndex(trackIndex),
+                                          &track.GetTrackAtIndex(trackIndex + 1)};
+
+    return std::any_of(std::begin(checkTracks), std::end(checkTracks), [&](const TrackSegment* checkTrack){
+            const TrackSegment &track = *checkTrack;
 
-    return std::any_of(checkTracks.begin(), checkTracks.end(), [&](TrackSegment track){
-            if (std::abs(gamex - track.gamex) > width) return false;                                                 // player gamex is not within track bounds
+            if (std::abs(gamex - track.gamex) > width) return false;                                                    // player gamex is not within track bounds
 
             if (track.checkpoint && track.gamex > checkx) {                                                             // update checkpoint position as player is within bounds
                 checkx = track.gamex;
                 checky = track.gamey - height;
 
-                printf("CHECKPOINT | x: %f, y: %f\n", checkx, checky);
+                LOG_DEBUG("CHECKPOINT | x: %f, y: %f", checkx, checky);
             }
 
             // Get vertical distance and ensure player is falling onto track not jumping up into it
             int verticalDist = int((track.gamey - track.height/2.0) - (gamey + height / 2.0));
             double dy_dt = gravity * timeSinceOnTrack - speedy;                                                         //dy_dt is the rate of change of player's height. if + then falling
 
-            if (std::abs(verticalDist) <= 5 && dy_dt >= 0) {                                                         // player is within vertical bounds and falling
+            if (std::abs(verticalDist) <= 5 && dy_dt >= 0) {                                                            // player is within vertical bounds and falling
                 gamey = track.gamey - height;
                 return true;
             }
@@ -118,7 +118,7 @@ bool Player::CheckVoidOut(int GAME_WINDOW_HEIGHT, Uint64 &ELAPSED_TIME) {
     // minus life
     lives -= 1;
 
-    printf("VO | GOTO x: %f, y: %f\n", gamey, gamex);
+    LOG_INFO("VO | GOTO x: %f, y: %f", gamex, gamey);
 
     return true;
 }
@@ -153,7 +153,7 @@ void Player::Jump(bool jumpInput) {
 
 bool Player::AtEndOfTrack(Track &track) {
     // This function determines if the payer is currently above a trackSegment with the "endLevel" var set to true
-    TrackSegment currentTrack = track.GetTrackAtIndex(int(gamex / width));                                     // get current track player is on
+    const TrackSegment &currentTrack = track.GetTrackAtIndex(int(gamex / width));                                       // get current track player is on
 
     if (currentTrack.endLevel) {                                                                                        // prevent jumping and falling
         speedy = 0;
@@ -168,17 +168,11 @@ bool Player::AtEndOfTrack(Track &track) {
 
 
 
-void Player::CreateTexture(SDL_Renderer* RENDERER) {
-    // Create player model Texture
-    surface = IMG_Load("../Resources/Images/Player/PlayerModel.png");
-    playerTexture = SDL_CreateTextureFromSurface(RENDERER, surface);
-    SDL_FreeSurface(surface);
-}
-
-void Player::Display(Track& track, Uint64 ELAPSED_TIME, SDL_Renderer* RENDERER){
+void Player::UpdateRectPosition(Track& track, Uint64 ELAPSED_TIME) {
     /*
      * This function handles the 3 display states of the player, to provide animations letting it move onto and off the
-     * screen horizontally at the start and end of the level.
+     * screen horizontally at the start and end of the level. The rect position is also used by OnScreen to determine
+     * the end of the level, so is updated by the simulation rather than when displaying.
      */
 
     // set default rect values
@@ -186,18 +180,13 @@ void Player::Display(Track& track, Uint64 ELAPSED_TIME, SDL_Renderer* RENDERER){
     rectx= offsetx;
 
     // Determine display type for providing different rect values
-    TrackSegment currentTrack = track.GetTrackAtIndex(int(gamex / width));
+    const TrackSegment &currentTrack = track.GetTrackAtIndex(int(gamex / width));
     if (currentTrack.startLevel) {
         rectx = (gamex - offsetx < offsetx) ? double(ELAPSED_TIME) * speedx : offsetx;
     }
     if (currentTrack.endLevel) {
         rectx = (double(ELAPSED_TIME) * (speedx)) - gamex + (2*offsetx);
     }
-
-    playerRect.x = int(int(rectx) - (width / 2.0));
-    playerRect.y = int(recty - (height / 2.0));
-
-    SDL_RenderCopy(RENDERER, playerTexture, nullptr, &playerRect);
 }
 
 
@@ -212,20 +201,27 @@ bool Player::OnScreen(int xMin, int xMax) const {
     return (xMin <= rectx && rectx <= xMax);
 }
 
-std::vector<double> Player::GetGamePosition() {
+Vector2D Player::GetGamePosition() const {
     return {gamex, gamey};
 }
 
-std::vector<double> Player::GetPlayerSpeed() {
-    return {speedx, speedy};
+ObjectStruct Player::GetCollisionStruct() const {
+    // position and size of the player, as used by TrackObject::PlayerCollision
+    ObjectStruct playerStruct {};
+    playerStruct.Construct(gamex, gamey, width, height);
+    return playerStruct;
 }
 
-std::vector<int> Player::GetPlayerWidthHeight() {
-    return {width, height};
+Vector2D Player::GetRectPosition() const {
+    return {rectx, recty};
+}
+
+Vector2D Player::GetPlayerSpeed() const {
+    return {speedx, speedy};
 }
 
-SDL_Texture* Player::GetTexture() {
-    return playerTexture;
+Size2D Player::GetPlayerWidthHeight() const {
+    return {width, height};
 }
 
 
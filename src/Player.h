@@ -12,6 +12,7 @@
 
 class Track;
 struct TrackSegment;
+struct ObjectStruct;
 
 
 
@@ -39,11 +40,6 @@ class Player
         // vars for score tracking
         int lives = 3;
 
-        // SDL and Display vars
-        SDL_Texture* playerTexture{};
-        SDL_Rect playerRect {};
-        SDL_Surface* surface{};
-
         int width;
         int height;
 
@@ -56,21 +52,21 @@ class Player
         // Player movement
         void MovementUpdate(Track &track, Uint64 tickchange, Uint64 ELAPSED_TIME);
         bool AtEndOfTrack(Track &track);
-        bool WithinTrackBounds(Track track);
+        bool WithinTrackBounds(const Track& track);
         bool CheckVoidOut(int GAME_WINDOW_HEIGHT, Uint64 &ELAPSED_TIME);
         void Jump(bool jumpInput);
 
         // Display
-        void CreateTexture(SDL_Renderer* RENDERER);
-        void Display(Track &track, Uint64 ELAPSED_TIME, SDL_Renderer* RENDERER);
+        void UpdateRectPosition(Track &track, Uint64 ELAPSED_TIME);
 
         // Getters
         int GetLives() const;
         bool OnScreen(int xMin, int xMax) const;
-        std::vector<double> GetGamePosition();
-        std::vector<double> GetPlayerSpeed();
-        std::vector<int> GetPlayerWidthHeight();
-        SDL_Texture* GetTexture();
+        Vector2D GetGamePosition() const;
+        ObjectStruct GetCollisionStruct() const;
+        Vector2D GetRectPosition() const;
+        Vector2D GetPlayerSpeed() const;
+        Size2D GetPlayerWidthHeight() const;
 
         // Setters
         void ForceVoidOut();
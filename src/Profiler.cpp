@@ -0,0 +1,156 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#include "Profiler.h"
+#include "TextRenderer.h"
+#include "Renderer.h"
+
+const char* ProfilePhaseName(ProfilePhase phase) {
+    static const char* names[PROFILE_PHASES] = {
+            "frame", "events", "simulation", "movement", "pickups", "collision", "streaming",
+            "background", "display track", "display player", "display items", "display hud", "present"
+    };
+    return names[phase];
+}
+
+
+
+
+
+#ifdef ENABLE_PROFILER
+
+Profiler& Profiler::Get() {
+    // Timers are added from any thread, everything else is only used from the render thread
+    static Profiler profiler;
+    return profiler;
+}
+
+void Profiler::EndFrame() {
+    // Moves the totals of the frame into the rolling window and the whole run histogram. Time recorded outside of a
+    // PROFILE_FRAME scope (such as headless steps) is discarded
+    if (phases[PROFILE_FRAME].frameCalls == 0) {
+        for (PhaseHistory& phase : phases) phase.frameNs = phase.frameCalls = 0;
+        return;
+    }
+
+    int slot = int(frames % WINDOW_FRAMES);
+    for (PhaseHistory& phase : phases) {
+        Uint64 frameNs = phase.frameNs.exchange(0, std::memory_order_relaxed);
+        Uint64 frameCalls = phase.frameCalls.exchange(0, std::memory_order_relaxed);
+        double ms = double(frameNs) / 1e6;
+        phase.windowMs[slot] = float(ms);
+
+        phase.minMs = (frames == 0) ? ms : std::min(phase.minMs, ms);
+        phase.maxMs = std::max(phase.maxMs, ms);
+        phase.totalNs += frameNs;
+        phase.totalCalls += frameCalls;
+        phase.histogram[std::min(HISTOGRAM_BUCKETS - 1, int(ms / BUCKET_MS))]++;
+    }
+    frames++;
+
+    // refresh the overlay text every 15 frames, so it is readable. The lines are written in place, allocating nothing
+    if (!overlayShown || frames % 15 != 0) return;
+    for (int p = 0; p < PROFILE_PHASES; p++) {
+        PhaseStats stats = GetWindowStats(ProfilePhase(p));
+        snprintf(overlayLines[p].data(), OVERLAY_LINE_LENGTH, "%-15s min %6.3f  avg %6.3f  p99 %6.3f ms",
+                 ProfilePhaseName(ProfilePhase(p)), stats.minMs, stats.avgMs, stats.p99Ms);
+    }
+}
+
+
+
+
+
+Profiler::PhaseStats Profiler::GetWindowStats(ProfilePhase phase) const {
+    // Stats over the frames in the rolling window
+    PhaseStats stats {};
+    int count = int(std::min<Uint64>(frames, WINDOW_FRAMES));
+    if (count == 0) return stats;
+
+    std::array<float, WINDOW_FRAMES> sorted = phases[phase].windowMs;
+    std::sort(sorted.begin(), sorted.begin() + count);
+
+    double total = 0;
+    for (int i = 0; i < count; i++) total += sorted[i];
+    stats.minMs = sorted[0];
+    stats.maxMs = sorted[count - 1];
+    stats.avgMs = total / count;
+    stats.p99Ms = sorted[std::min(count - 1, int(count * 0.99))];
+    return stats;
+}
+
+double Profiler::HistogramPercentile(const PhaseHistory& phase, Uint64 count, double percentile) {
+    // upper edge of the bucket holding the percentile
+    Uint64 target = Uint64(std::ceil(double(count) * percentile));
+    Uint64 seen = 0;
+    for (int b = 0; b < HISTOGRAM_BUCKETS; b++) {
+        seen += phase.histogram[b];
+        if (seen >= target) return std::min((b + 1) * BUCKET_MS, phase.maxMs);
+    }
+    return phase.maxMs;
+}
+
+Profiler::PhaseStats Profiler::GetRunStats(ProfilePhase phase) const {
+    // Stats over every frame since the start of the program, the p99 is accurate to BUCKET_MS
+    PhaseStats stats {};
+    if (frames == 0) return stats;
+
+    const PhaseHistory& history = phases[phase];
+    stats.minMs = history.minMs;
+    stats.maxMs = history.maxMs;
+    stats.avgMs = double(history.totalNs) / 1e6 / double(frames);
+    stats.p99Ms = HistogramPercentile(history, frames, 0.99);
+    stats.callsPerFrame = double(history.totalCalls) / double(frames);
+    return stats;
+}
+
+
+
+
+
+void Profiler::ToggleOverlay() {
+    overlayShown = !overlayShown;
+}
+
+void Profiler::DrawOverlay(Renderer& renderer, const GlyphAtlas& atlas, int x, int y, int lineHeight) {
+    // Draws the rolling stats of each phase as lines of text, over a dark background
+    if (!overlayShown || overlayLines[0][0] == '\0') return;
+
+    int width = 0;
+    for (const auto& line : overlayLines) width = std::max(width, atlas.MeasureWidth(line.data(), lineHeight));
+
+    SDL_Rect background {x, y, width + lineHeight, (PROFILE_PHASES + 1) * lineHeight};
+    renderer.FillRect(background, {0, 0, 0, 180});
+
+    for (int p = 0; p < PROFILE_PHASES; p++) {
+        SDL_Rect lineRect {x + lineHeight / 2, y + lineHeight / 2 + p * lineHeight,
+                           atlas.MeasureWidth(overlayLines[p].data(), lineHeight), lineHeight};
+        atlas.Draw(renderer, overlayLines[p].data(), lineRect);
+    }
+}
+
+bool Profiler::WriteCSV(const std::string& path) const {
+    // Writes the whole run stats of each phase, in ms per frame
+    if (frames == 0) return false;
+
+    std::ofstream csvFile(path);
+    if (!csvFile.is_open()) {
+        printf("PROFILER | ERROR: could not create %s\n", path.c_str());
+        return false;
+    }
+
+    csvFile << "phase,frames,calls_per_frame,min_ms,avg_ms,p99_ms,max_ms\n";
+    for (int p = 0; p < PROFILE_PHASES; p++) {
+        PhaseStats stats = GetRunStats(ProfilePhase(p));
+        char row[160];
+        snprintf(row, sizeof(row), "%s,%llu,%.2f,%.4f,%.4f,%.4f,%.4f\n", ProfilePhaseName(ProfilePhase(p)),
+                 (unsigned long long)frames, stats.callsPerFrame, stats.minMs, stats.avgMs, stats.p99Ms, stats.maxMs);
+        csvFile << row;
+    }
+
+    printf("PROFILER | %llu frames written to %s\n", (unsigned long long)frames, path.c_str());
+    return true;
+}
+
+#endif
@@ -0,0 +1,157 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#ifndef CPP_PROGRAMMINGPROJECT_PROFILER_H
+#define CPP_PROGRAMMINGPROJECT_PROFILER_H
+
+#include "GameCore.h"
+#include "Trace.h"
+#include <array>
+#include <atomic>
+
+// Phases of a frame that are timed. Simulation phases are summed over all the steps taken during a frame, on the
+// simulation thread
+enum ProfilePhase {
+    PROFILE_FRAME,
+    PROFILE_EVENTS,
+    PROFILE_SIMULATION,
+    PROFILE_MOVEMENT,
+    PROFILE_PICKUPS,
+    PROFILE_COLLISION,
+    PROFILE_STREAMING,
+    PROFILE_BACKGROUND,
+    PROFILE_DISPLAY_TRACK,
+    PROFILE_DISPLAY_PLAYER,
+    PROFILE_DISPLAY_ITEMS,
+    PROFILE_DISPLAY_HUD,
+    PROFILE_PRESENT,
+    PROFILE_PHASES
+};
+
+const char* ProfilePhaseName(ProfilePhase phase);
+
+#ifdef ENABLE_PROFILER
+
+/*
+ * Collects the time spent in each ProfilePhase. Scoped timers on the render or simulation thread add to the current
+ * frame's totals, which EndFrame moves into a rolling window of the last WINDOW_FRAMES frames (shown by the overlay),
+ * and into a histogram over the whole run (written to the CSV). Nothing is allocated once constructed.
+ */
+class Profiler {
+    public:
+        struct PhaseStats {
+            double minMs = 0, avgMs = 0, p99Ms = 0, maxMs = 0;
+            double callsPerFrame = 0;
+        };
+
+        static const int WINDOW_FRAMES = 240;
+        static const int HISTOGRAM_BUCKETS = 2500;
+        static constexpr double BUCKET_MS = 0.02;                                                                       // histogram covers 0 to 50 ms
+
+    private:
+        struct PhaseHistory {
+            std::atomic<Uint64> frameNs {0};                                                                            // time in the current frame
+            std::atomic<Uint64> frameCalls {0};
+            std::array<float, WINDOW_FRAMES> windowMs {};
+
+            // whole run
+            Uint64 totalNs = 0, totalCalls = 0;
+            double minMs = 0, maxMs = 0;
+            std::array<uint32_t, HISTOGRAM_BUCKETS> histogram {};
+        };
+
+        static const int OVERLAY_LINE_LENGTH = 96;
+
+        std::array<PhaseHistory, PROFILE_PHASES> phases {};
+        Uint64 frames = 0;
+        bool overlayShown = false;
+        std::array<std::array<char, OVERLAY_LINE_LENGTH>, PROFILE_PHASES> overlayLines {};                              // refreshed a few times a second
+
+        static double HistogramPercentile(const PhaseHistory& phase, Uint64 count, double percentile);
+
+    public:
+        static Profiler& Get();
+
+        void Add(ProfilePhase phase, Uint64 ns) {
+            phases[phase].frameNs.fetch_add(ns, std::memory_order_relaxed);
+            phases[phase].frameCalls.fetch_add(1, std::memory_order_relaxed);
+        }
+        void EndFrame();
+
+        PhaseStats GetWindowStats(ProfilePhase phase) const;
+        PhaseStats GetRunStats(ProfilePhase phase) const;
+
+        void ToggleOverlay();
+        void DrawOverlay(Renderer& renderer, const GlyphAtlas& atlas, int x, int y, int lineHeight);
+        bool WriteCSV(const std::string& path) const;
+};
+
+#define PROFILE_END_FRAME() Profiler::Get().EndFrame()
+#define PROFILE_TOGGLE_OVERLAY() Profiler::Get().ToggleOverlay()
+#define PROFILE_DRAW_OVERLAY(renderer, atlas, x, y, lineHeight) \
+    Profiler::Get().DrawOverlay(renderer, atlas, x, y, lineHeight)
+#define PROFILE_WRITE_CSV(path) Profiler::Get().WriteCSV(path)
+
+#else
+
+// Profiler disabled, the overlay compiles to nothing
+#define PROFILE_END_FRAME() ((void)0)
+#define PROFILE_TOGGLE_OVERLAY() ((void)0)
+#define PROFILE_DRAW_OVERLAY(renderer, atlas, x, y, lineHeight) ((void)0)
+#define PROFILE_WRITE_CSV(path) ((void)0)
+
+#endif
+
+
+
+
+
+#if defined(ENABLE_PROFILER) || defined(ENABLE_TRACING)
+
+// Adds the time from construction to destruction to a phase, and records it as a trace event if tracing
+class ProfileScope {
+    private:
+        ProfilePhase phase;
+        bool traced;
+        std::chrono::steady_clock::time_point start {};
+
+    public:
+        explicit ProfileScope(ProfilePhase timedPhase) : phase(timedPhase), traced(false) {
+#ifdef ENABLE_TRACING
+            // the phases within a step are too short and frequent to be worth a trace event each
+            traced = phase != PROFILE_MOVEMENT && phase != PROFILE_PICKUPS && phase != PROFILE_COLLISION
+                     && Tracer::Get().IsRecording();
+#endif
+#ifndef ENABLE_PROFILER
+            if (!traced) return;                                                                                        // clock only read when needed
+#endif
+            start = std::chrono::steady_clock::now();
+        }
+        ~ProfileScope() {
+#ifndef ENABLE_PROFILER
+            if (!traced) return;
+#endif
+            auto end = std::chrono::steady_clock::now();
+#ifdef ENABLE_PROFILER
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+            Profiler::Get().Add(phase, Uint64(ns.count()));
+#endif
+#ifdef ENABLE_TRACING
+            if (traced) Tracer::Get().Record(ProfilePhaseName(phase), "frame", start, end);
+#endif
+        }
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(phase) ProfileScope PROFILE_CONCAT(profileScope, __LINE__) {phase}
+
+#else
+
+// Profiler and tracing disabled, timers compile to nothing
+#define PROFILE_SCOPE(phase)
+
+#endif
+
+#endif //CPP_PROGRAMMINGPROJECT_PROFILER_H
@@ -0,0 +1,45 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#include "Random.h"
+
+static const uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ull;
+
+RandomStream::RandomStream(unsigned int seed, int difficulty, RandomSubsystem subsystem, int chunk) {
+    // combine each part of the stream id in turn, so streams differing in any part are unrelated
+    key = Mix(uint64_t(seed) + GOLDEN_GAMMA);
+    key = Mix(key ^ uint64_t(uint32_t(difficulty)));
+    key = Mix(key ^ uint64_t(subsystem));
+    key = Mix(key ^ uint64_t(uint32_t(chunk)));
+}
+
+uint64_t RandomStream::Mix(uint64_t value) {
+    // SplitMix64 finaliser
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+
+
+
+
+uint64_t RandomStream::At(uint64_t index) const {
+    // value at position index of the stream
+    return Mix(key + (index + 1) * GOLDEN_GAMMA);
+}
+
+uint64_t RandomStream::Next() {
+    return At(counter++);
+}
+
+int RandomStream::Below(int bound) {
+    // next value from 0 to bound - 1, replaces std::rand() % bound
+    return BelowAt(counter++, bound);
+}
+
+int RandomStream::BelowAt(uint64_t index, int bound) const {
+    // scales the top 32 bits to the bound rather than taking a modulo, so no division is needed
+    return int(((At(index) >> 32) * uint64_t(bound)) >> 32);
+}
@@ -0,0 +1,41 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#ifndef CPP_PROGRAMMINGPROJECT_RANDOM_H
+#define CPP_PROGRAMMINGPROJECT_RANDOM_H
+
+#include <cstdint>
+
+// Parts of generation that draw from their own stream, so that changing one does not change the others
+enum RandomSubsystem {
+    RANDOM_LAYOUT = 1,                                                                                                  // track sections, jumps and obstacles
+    RANDOM_COINS = 2,
+    RANDOM_SPECIALS = 3,
+};
+
+/*
+ * Counter based random number stream. The n-th value of a stream is the SplitMix64 hash of its key and n, so values
+ * do not depend on any shared state and can also be fetched out of order with At(). The key is derived from
+ * (seed, difficulty, subsystem, chunk), giving each part of each level its own independent stream. Any part of a
+ * level can therefore be regenerated on any thread with identical results.
+ */
+class RandomStream {
+    private:
+        uint64_t key = 0;
+        uint64_t counter = 0;
+
+    public:
+        RandomStream() = default;
+        RandomStream(unsigned int seed, int difficulty, RandomSubsystem subsystem, int chunk);
+
+        static uint64_t Mix(uint64_t value);
+
+        uint64_t At(uint64_t index) const;
+        uint64_t Next();
+        int Below(int bound);
+        int BelowAt(uint64_t index, int bound) const;
+};
+
+
+#endif //CPP_PROGRAMMINGPROJECT_RANDOM_H
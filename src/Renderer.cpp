@@ -0,0 +1,221 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#include "Renderer.h"
+
+SDLRenderer::SDLRenderer(SDL_Renderer* RENDERER) {
+    renderer = RENDERER;
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);                                                          // for translucent filled rects
+}
+
+void SDLRenderer::Copy(SDL_Texture* texture, const SDL_Rect* srcRect, const SDL_Rect& destRect) {
+    SDL_RenderCopy(renderer, texture, srcRect, &destRect);
+}
+
+void SDLRenderer::Geometry(SDL_Texture* texture, const SDL_Vertex* vertices, int vertexCount, const int* indices,
+                           int indexCount) {
+    SDL_RenderGeometry(renderer, texture, vertices, vertexCount, indices, indexCount);
+}
+
+void SDLRenderer::FillRect(const SDL_Rect& rect, SDL_Color color) {
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    SDL_RenderFillRect(renderer, &rect);
+}
+
+void SDLRenderer::SetTarget(SDL_Texture* target) {
+    SDL_SetRenderTarget(renderer, target);
+}
+
+SDL_Texture* SDLRenderer::GetTarget() const {
+    return SDL_GetRenderTarget(renderer);
+}
+
+void SDLRenderer::Clear(SDL_Color color) {
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    SDL_RenderClear(renderer);
+}
+
+void SDLRenderer::Present() {
+    SDL_RenderPresent(renderer);
+}
+
+
+
+
+
+RenderStats& RenderStats::operator+=(const RenderStats& other) {
+    drawCalls += other.drawCalls;
+    sprites += other.sprites;
+    textureSwitches += other.textureSwitches;
+    targetSwitches += other.targetSwitches;
+    clears += other.clears;
+    pixelsCovered += other.pixelsCovered;
+    return *this;
+}
+
+RenderStats operator-(const RenderStats& lhs, const RenderStats& rhs) {
+    RenderStats difference;
+    difference.drawCalls = lhs.drawCalls - rhs.drawCalls;
+    difference.sprites = lhs.sprites - rhs.sprites;
+    difference.textureSwitches = lhs.textureSwitches - rhs.textureSwitches;
+    difference.targetSwitches = lhs.targetSwitches - rhs.targetSwitches;
+    difference.clears = lhs.clears - rhs.clears;
+    difference.pixelsCovered = lhs.pixelsCovered - rhs.pixelsCovered;
+    return difference;
+}
+
+
+
+
+
+RecordingRenderer::RecordingRenderer(int windowWidth, int windowHeight) {
+    outputWidth = targetWidth = windowWidth;
+    outputHeight = targetHeight = windowHeight;
+}
+
+void RecordingRenderer::AddCoverage(const SDL_Rect& rect) {
+    int x1 = std::max(rect.x, 0), x2 = std::min(rect.x + rect.w, targetWidth);
+    int y1 = std::max(rect.y, 0), y2 = std::min(rect.y + rect.h, targetHeight);
+    if (x2 > x1 && y2 > y1) current.pixelsCovered += Uint64(x2 - x1) * Uint64(y2 - y1);
+}
+
+void RecordingRenderer::UseTexture(SDL_Texture* texture) {
+    if (!textureBound || texture != lastTexture) current.textureSwitches++;                                             // the first draw of a batch binds its texture
+    lastTexture = texture;
+    textureBound = true;
+}
+
+void RecordingRenderer::Copy(SDL_Texture* texture, const SDL_Rect* srcRect, const SDL_Rect& destRect) {
+    commands.push_back({RenderCommand::COPY, texture, srcRect != nullptr, srcRect ? *srcRect : SDL_Rect {}, destRect,
+                        SDL_Color {}, 0, 0, 0, 0});
+
+    current.drawCalls++;
+    current.sprites++;
+    UseTexture(texture);
+    AddCoverage(destRect);
+}
+
+void RecordingRenderer::Geometry(SDL_Texture* texture, const SDL_Vertex* vertexData, int vertexCount,
+                                 const int* indexData, int indexCount) {
+    commands.push_back({RenderCommand::GEOMETRY, texture, false, SDL_Rect {}, SDL_Rect {}, SDL_Color {},
+                        int(vertices.size()), vertexCount, int(indices.size()), indexCount});
+    vertices.insert(vertices.end(), vertexData, vertexData + vertexCount);
+    indices.insert(indices.end(), indexData, indexData + indexCount);
+
+    current.drawCalls++;
+    UseTexture(texture);
+
+    // the bounds of each quad
+    for (int i = 0; i < indexCount; i += 6) {
+        float x1 = vertexData[indexData[i]].position.x, x2 = x1;
+        float y1 = vertexData[indexData[i]].position.y, y2 = y1;
+        for (int corner = i + 1; corner < std::min(i + 6, indexCount); corner++) {
+            const SDL_FPoint& position = vertexData[indexData[corner]].position;
+            x1 = std::min(x1, position.x);
+            x2 = std::max(x2, position.x);
+            y1 = std::min(y1, position.y);
+            y2 = std::max(y2, position.y);
+        }
+        AddCoverage({int(x1), int(y1), int(x2) - int(x1), int(y2) - int(y1)});
+        current.sprites++;
+    }
+}
+
+void RecordingRenderer::FillRect(const SDL_Rect& rect, SDL_Color color) {
+    commands.push_back({RenderCommand::FILL_RECT, nullptr, false, SDL_Rect {}, rect, color, 0, 0, 0, 0});
+
+    current.drawCalls++;
+    AddCoverage(rect);
+}
+
+void RecordingRenderer::SetTarget(SDL_Texture* newTarget) {
+    commands.push_back({RenderCommand::SET_TARGET, newTarget, false, SDL_Rect {}, SDL_Rect {}, SDL_Color {}, 0, 0, 0,
+                        0});
+
+    current.targetSwitches++;
+    textureBound = false;                                                                                               // changing target ends the batch
+    target = newTarget;
+    targetWidth = outputWidth;
+    targetHeight = outputHeight;
+    if (target) SDL_QueryTexture(target, nullptr, nullptr, &targetWidth, &targetHeight);
+}
+
+SDL_Texture* RecordingRenderer::GetTarget() const {
+    return target;
+}
+
+void RecordingRenderer::Clear(SDL_Color color) {
+    commands.push_back({RenderCommand::CLEAR, nullptr, false, SDL_Rect {}, SDL_Rect {}, color, 0, 0, 0, 0});
+    current.clears++;
+}
+
+void RecordingRenderer::Present() {
+    // Ends the frame, keeping its commands and stats until the next Present
+    std::swap(commands, frameCommands);
+    std::swap(vertices, frameVertices);
+    std::swap(indices, frameIndices);
+    commands.clear();
+    vertices.clear();
+    indices.clear();
+
+    lastFrame = current;
+    total += current;
+    current = {};
+    frames++;
+    textureBound = false;
+}
+
+void RecordingRenderer::Playback(Renderer& renderer) const {
+    // Issues the commands of the last presented frame to renderer, without presenting
+    for (const RenderCommand& command : frameCommands) {
+        switch (command.type) {
+            case RenderCommand::COPY:
+                renderer.Copy(command.texture, command.hasSrcRect ? &command.srcRect : nullptr, command.destRect);
+                break;
+
+            case RenderCommand::GEOMETRY:
+                renderer.Geometry(command.texture, frameVertices.data() + command.firstVertex, command.vertexCount,
+                                  frameIndices.data() + command.firstIndex, command.indexCount);
+                break;
+
+            case RenderCommand::FILL_RECT:
+                renderer.FillRect(command.destRect, command.color);
+                break;
+
+            case RenderCommand::SET_TARGET:
+                renderer.SetTarget(command.texture);
+                break;
+
+            case RenderCommand::CLEAR:
+                renderer.Clear(command.color);
+                break;
+        }
+    }
+}
+
+void RecordingRenderer::ResetStats() {
+    lastFrame = {};
+    total = {};
+    frames = 0;
+}
+
+const RenderStats& RecordingRenderer::GetCurrentStats() const {
+    return current;
+}
+
+const RenderStats& RecordingRenderer::GetFrameStats() const {
+    return lastFrame;
+}
+
+const RenderStats& RecordingRenderer::GetTotalStats() const {
+    return total;
+}
+
+Uint64 RecordingRenderer::GetFrameCount() const {
+    return frames;
+}
+
+const std::vector<RenderCommand>& RecordingRenderer::GetFrameCommands() const {
+    return frameCommands;
+}
@@ -0,0 +1,164 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#ifndef CPP_PROGRAMMINGPROJECT_RENDERER_H
+#define CPP_PROGRAMMINGPROJECT_RENDERER_H
+
+#include "GameCore.h"
+
+/*
+ * Draw calls made by the game objects each frame. Textures are still created by the AssetCache from an SDL_Renderer,
+ * only drawing goes through this interface, so the same display code can draw to the window, to nothing when headless,
+ * or into a recording for measuring what a frame costs without a GPU.
+ */
+class Renderer {
+    public:
+        virtual ~Renderer() = default;
+
+        virtual void Copy(SDL_Texture* texture, const SDL_Rect* srcRect, const SDL_Rect& destRect) = 0;
+        virtual void Geometry(SDL_Texture* texture, const SDL_Vertex* vertices, int vertexCount, const int* indices,
+                              int indexCount) = 0;
+        virtual void FillRect(const SDL_Rect& rect, SDL_Color color) = 0;                                               // alpha blended
+        virtual void SetTarget(SDL_Texture* target) = 0;                                                                // nullptr for the window
+        virtual SDL_Texture* GetTarget() const = 0;
+        virtual void Clear(SDL_Color color) = 0;
+        virtual void Present() = 0;
+};
+
+// Sets the target of a renderer, and restores the target it replaced when destroyed, so layers can be composed whilst
+// another target is being drawn to
+class ScopedRenderTarget {
+    private:
+        Renderer& renderer;
+        SDL_Texture* previousTarget;
+
+    public:
+        ScopedRenderTarget(Renderer& targetRenderer, SDL_Texture* target) :
+                renderer(targetRenderer),
+                previousTarget(targetRenderer.GetTarget()) {
+            renderer.SetTarget(target);
+        }
+        ~ScopedRenderTarget() {
+            renderer.SetTarget(previousTarget);
+        }
+        ScopedRenderTarget(const ScopedRenderTarget&) = delete;
+        ScopedRenderTarget& operator=(const ScopedRenderTarget&) = delete;
+};
+
+// Draws to an SDL_Renderer, which is owned by the caller
+class SDLRenderer : public Renderer {
+    private:
+        SDL_Renderer* renderer;
+
+    public:
+        explicit SDLRenderer(SDL_Renderer* RENDERER);
+
+        void Copy(SDL_Texture* texture, const SDL_Rect* srcRect, const SDL_Rect& destRect) override;
+        void Geometry(SDL_Texture* texture, const SDL_Vertex* vertices, int vertexCount, const int* indices,
+                      int indexCount) override;
+        void FillRect(const SDL_Rect& rect, SDL_Color color) override;
+        void SetTarget(SDL_Texture* target) override;
+        SDL_Texture* GetTarget() const override;
+        void Clear(SDL_Color color) override;
+        void Present() override;
+};
+
+// Draws nothing, so only the cost of deciding what to draw remains
+class NullRenderer : public Renderer {
+    private:
+        SDL_Texture* target = nullptr;
+
+    public:
+        void Copy(SDL_Texture*, const SDL_Rect*, const SDL_Rect&) override {}
+        void Geometry(SDL_Texture*, const SDL_Vertex*, int, const int*, int) override {}
+        void FillRect(const SDL_Rect&, SDL_Color) override {}
+        void SetTarget(SDL_Texture* newTarget) override {
+            target = newTarget;
+        }
+        SDL_Texture* GetTarget() const override {
+            return target;
+        }
+        void Clear(SDL_Color) override {}
+        void Present() override {}
+};
+
+
+
+
+
+struct RenderCommand {
+    enum Type {COPY, GEOMETRY, FILL_RECT, SET_TARGET, CLEAR};
+
+    Type type;
+    SDL_Texture* texture;                                                                                               // source of a copy or geometry, or the new target
+    bool hasSrcRect;
+    SDL_Rect srcRect;
+    SDL_Rect destRect;
+    SDL_Color color;
+    int firstVertex, vertexCount, firstIndex, indexCount;                                                               // geometry, in the recorder's buffers
+};
+
+struct RenderStats {
+    Uint64 drawCalls = 0;                                                                                               // copies, geometry and filled rects
+    Uint64 sprites = 0;                                                                                                 // copies and quads of geometry
+    Uint64 textureSwitches = 0;                                                                                         // copies from a different texture to the last copy
+    Uint64 targetSwitches = 0;
+    Uint64 clears = 0;
+    Uint64 pixelsCovered = 0;                                                                                           // area drawn to, clipped to the target, not counting clears
+
+    RenderStats& operator+=(const RenderStats& other);
+};
+
+RenderStats operator-(const RenderStats& lhs, const RenderStats& rhs);
+
+/*
+ * Records the commands of each frame instead of drawing them, counting the draw calls, texture switches and pixels
+ * covered. A frame ends at Present, after which the commands and stats of that frame can be read, or played back to
+ * another renderer. The command buffers are reused, so recording allocates nothing once they have grown to fit a frame.
+ * Geometry is counted as quads of 6 indices, as it is submitted by a SpriteBatch.
+ */
+class RecordingRenderer : public Renderer {
+    private:
+        int outputWidth, outputHeight;
+        SDL_Texture* target = nullptr;
+        int targetWidth, targetHeight;                                                                                  // size draws are clipped to
+        SDL_Texture* lastTexture = nullptr;
+        bool textureBound = false;
+
+        std::vector<RenderCommand> commands {};                                                                         // current frame
+        std::vector<RenderCommand> frameCommands {};                                                                    // last presented frame
+        std::vector<SDL_Vertex> vertices {}, frameVertices {};
+        std::vector<int> indices {}, frameIndices {};
+        RenderStats current {};
+        RenderStats lastFrame {};
+        RenderStats total {};
+        Uint64 frames = 0;
+
+        void AddCoverage(const SDL_Rect& rect);
+        void UseTexture(SDL_Texture* texture);
+
+    public:
+        RecordingRenderer(int windowWidth, int windowHeight);
+
+        void Copy(SDL_Texture* texture, const SDL_Rect* srcRect, const SDL_Rect& destRect) override;
+        void Geometry(SDL_Texture* texture, const SDL_Vertex* vertices, int vertexCount, const int* indices,
+                      int indexCount) override;
+        void FillRect(const SDL_Rect& rect, SDL_Color color) override;
+        void SetTarget(SDL_Texture* target) override;
+        SDL_Texture* GetTarget() const override;
+        void Clear(SDL_Color color) override;
+        void Present() override;
+
+        void Playback(Renderer& renderer) const;
+        void ResetStats();
+
+        // Getters
+        const RenderStats& GetCurrentStats() const;                                                                     // frame being recorded
+        const RenderStats& GetFrameStats() const;                                                                       // last presented frame
+        const RenderStats& GetTotalStats() const;
+        Uint64 GetFrameCount() const;
+        const std::vector<RenderCommand>& GetFrameCommands() const;
+};
+
+#endif //CPP_PROGRAMMINGPROJECT_RENDERER_H
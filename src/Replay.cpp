@@ -0,0 +1,281 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#include "Replay.h"
+
+static const char REPLAY_MAGIC[4] = {'S', 'R', 'P', 'L'};
+static const uint8_t REPLAY_VERSION = 1;
+
+ReplayWriter::~ReplayWriter() {
+    Flush();
+}
+
+bool ReplayWriter::Open(const std::string& path, const ReplayHeader& header, std::string& error) {
+    // Creates the replay file at path and writes the header, the events are then recorded as the session is stepped
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        error = "could not create " + path;
+        return false;
+    }
+
+    buffer.reserve(BUFFER_SIZE);
+    buffer.insert(buffer.end(), REPLAY_MAGIC, REPLAY_MAGIC + 4);
+    buffer.push_back(REPLAY_VERSION);
+    WriteVarint(header.seed);
+    WriteVarint(Uint64(header.windowWidth));
+    WriteVarint(Uint64(header.windowHeight));
+    WriteVarint(header.endless ? 1 : 0);
+    return true;
+}
+
+bool ReplayWriter::IsOpen() const {
+    return file.is_open();
+}
+
+void ReplayWriter::WriteVarint(Uint64 value) {
+    // 7 bits per byte, low bits first, with the top bit set on all but the last byte
+    while (value >= 0x80) {
+        buffer.push_back(uint8_t(value | 0x80));
+        value >>= 7;
+    }
+    buffer.push_back(uint8_t(value));
+    if (buffer.size() >= BUFFER_SIZE) Flush();
+}
+
+void ReplayWriter::WriteEvent(Uint64 tick, ReplayEventType type) {
+    WriteVarint(((tick - lastTick) << 3) | Uint64(type));
+    lastTick = tick;
+}
+
+void ReplayWriter::Flush() {
+    if (!file.is_open() || buffer.empty()) return;
+    file.write(reinterpret_cast<const char*>(buffer.data()), std::streamsize(buffer.size()));
+    bytesWritten += buffer.size();
+    buffer.clear();
+}
+
+
+
+
+
+void ReplayWriter::RecordInputs(Uint64 tick, const SessionInputs& inputs) {
+    // Only the inputs that have changed since the last step are written
+    if (!file.is_open()) return;
+
+    if (inputs.jumpHeld != lastInputs.jumpHeld) {
+        WriteEvent(tick, inputs.jumpHeld ? REPLAY_JUMP_DOWN : REPLAY_JUMP_UP);
+    }
+    if (inputs.pausePressed != lastInputs.pausePressed) {
+        WriteEvent(tick, inputs.pausePressed ? REPLAY_PAUSE_DOWN : REPLAY_PAUSE_UP);
+    }
+    if (inputs.resumePressed != lastInputs.resumePressed) {
+        WriteEvent(tick, inputs.resumePressed ? REPLAY_RESUME_DOWN : REPLAY_RESUME_UP);
+    }
+    lastInputs = inputs;
+}
+
+void ReplayWriter::RecordDifficulty(Uint64 tick, int difficulty) {
+    // Written when the level changes, so that playback can detect when it no longer follows the recording
+    if (!file.is_open() || difficulty == lastDifficulty) return;
+
+    WriteEvent(tick, REPLAY_LEVEL);
+    WriteVarint(Uint64(difficulty));
+    lastDifficulty = difficulty;
+}
+
+void ReplayWriter::Finish(Uint64 tick, int score) {
+    // Ends the recording at tick, the total number of steps taken, with the final score
+    if (!file.is_open()) return;
+
+    WriteEvent(tick, REPLAY_END);
+    WriteVarint(Uint64(std::max(0, score)));
+    Flush();
+    file.close();
+}
+
+Uint64 ReplayWriter::GetBytesWritten() const {
+    return bytesWritten + buffer.size();
+}
+
+
+
+
+
+bool ReplayReader::Open(const std::string& path, std::string& openError) {
+    // Opens the replay at path and reads its header. If the file is missing or not a replay, openError says why
+    file.open(path, std::ios::binary);
+    if (!file.is_open()) {
+        openError = "could not open " + path;
+        return false;
+    }
+
+    uint8_t magic[4] = {}, version = 0;
+    for (uint8_t& byte : magic) ReadByte(byte);
+    if (!std::equal(magic, magic + 4, REPLAY_MAGIC)) {
+        openError = path + " is not a replay file";
+        return false;
+    }
+    if (!ReadByte(version) || version != REPLAY_VERSION) {
+        openError = path + " has unsupported replay version " + std::to_string(version);
+        return false;
+    }
+
+    Uint64 seed = 0, width = 0, height = 0, endless = 0;
+    if (!ReadVarint(seed) || !ReadVarint(width) || !ReadVarint(height) || !ReadVarint(endless)) {
+        openError = path + " has a truncated header";
+        return false;
+    }
+    header.seed = unsigned(seed);
+    header.windowWidth = int(width);
+    header.windowHeight = int(height);
+    header.endless = endless != 0;
+
+    ReadEvent();
+    return true;
+}
+
+bool ReplayReader::ReadByte(uint8_t& byte) {
+    // Refill the buffer from the file once it has been used
+    if (bufferPos == bufferEnd) {
+        file.read(reinterpret_cast<char*>(buffer.data()), std::streamsize(buffer.size()));
+        bufferPos = 0;
+        bufferEnd = size_t(file.gcount());
+        if (bufferEnd == 0) return false;
+    }
+    byte = buffer[bufferPos++];
+    return true;
+}
+
+bool ReplayReader::ReadVarint(Uint64& value) {
+    value = 0;
+    uint8_t byte = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (!ReadByte(byte)) return false;
+        value |= Uint64(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;                                                                                                       // too long to be a valid varint
+}
+
+void ReplayReader::ReadEvent() {
+    // Reads the next event into eventTick, eventType and eventValue
+    Uint64 packed = 0;
+    eventPending = false;
+    if (!ReadVarint(packed)) {
+        if (!ended && error.empty()) error = "replay ends without an END event";
+        return;
+    }
+
+    eventTick += packed >> 3;
+    eventType = ReplayEventType(packed & 7);
+    eventValue = 0;
+    if ((eventType == REPLAY_LEVEL || eventType == REPLAY_END) && !ReadVarint(eventValue)) {
+        error = "replay is truncated";
+        return;
+    }
+    eventPending = true;
+}
+
+
+
+
+
+const SessionInputs& ReplayReader::InputsAt(Uint64 tick) {
+    while (eventPending && eventTick <= tick) {
+        switch (eventType) {
+            case REPLAY_JUMP_DOWN: inputs.jumpHeld = true; break;
+            case REPLAY_JUMP_UP: inputs.jumpHeld = false; break;
+            case REPLAY_PAUSE_DOWN: inputs.pausePressed = true; break;
+            case REPLAY_PAUSE_UP: inputs.pausePressed = false; break;
+            case REPLAY_RESUME_DOWN: inputs.resumePressed = true; break;
+            case REPLAY_RESUME_UP: inputs.resumePressed = false; break;
+            case REPLAY_LEVEL: difficulty = int(eventValue); break;
+            case REPLAY_END:
+                ended = true;
+                endTick = eventTick;
+                finalScore = int(eventValue);
+                eventPending = false;
+                return inputs;
+        }
+        ReadEvent();
+    }
+    return inputs;
+}
+
+const ReplayHeader& ReplayReader::GetHeader() const {
+    return header;
+}
+
+int ReplayReader::GetDifficulty() const {
+    return difficulty;
+}
+
+bool ReplayReader::Ended(Uint64 tick) const {
+    // true once tick has reached the END event, or the replay cannot be read any further
+    return (ended && tick >= endTick) || (!eventPending && !ended);
+}
+
+Uint64 ReplayReader::GetEndTick() const {
+    return endTick;
+}
+
+int ReplayReader::GetFinalScore() const {
+    return finalScore;
+}
+
+const std::string& ReplayReader::GetError() const {
+    return error;
+}
+
+
+
+
+
+ReplayResult PlayReplayHeadless(ReplayReader& replay) {
+    /*
+     * Steps a GameSession through the replay as fast as possible, with the inputs of each recorded step. The level
+     * difficulty is compared to the recording after every step, and the final tick and score at the end, with the
+     * result marked as desynced at the first difference.
+     */
+    const ReplayHeader& header = replay.GetHeader();
+    ReplayResult result {};
+    auto startTime = std::chrono::steady_clock::now();
+
+    GameSession session {header.windowWidth, header.windowHeight, header.seed, true, header.endless};
+    for (Uint64 tick = 0; !session.GameOver(); tick++) {
+        const SessionInputs& inputs = replay.InputsAt(tick);
+        if (replay.Ended(tick)) break;
+
+        session.Step(inputs);
+        result.ticks = tick + 1;
+
+        if (!header.endless && session.GetDifficulty() != replay.GetDifficulty()) {
+            result.desynced = true;
+            result.reason = "difficulty " + std::to_string(session.GetDifficulty()) + " at tick "
+                            + std::to_string(tick) + ", recorded " + std::to_string(replay.GetDifficulty());
+            break;
+        }
+    }
+    result.score = session.GetCollectables().GetScore();
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    // the session should end exactly where the recording did
+    replay.InputsAt(result.ticks);
+    if (result.desynced) return result;
+    if (!replay.GetError().empty()) {
+        result.desynced = true;
+        result.reason = replay.GetError();
+    }
+    else if (!replay.Ended(result.ticks)) {
+        result.desynced = true;
+        result.reason = "game over at tick " + std::to_string(result.ticks) + ", before the end of the recording";
+    }
+    else if (result.ticks != replay.GetEndTick() || result.score != replay.GetFinalScore()) {
+        result.desynced = true;
+        result.reason = "ended at tick " + std::to_string(result.ticks) + " with score " + std::to_string(result.score)
+                        + ", recorded tick " + std::to_string(replay.GetEndTick()) + " with score "
+                        + std::to_string(replay.GetFinalScore());
+    }
+    return result;
+}
@@ -0,0 +1,113 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#ifndef CPP_PROGRAMMINGPROJECT_REPLAY_H
+#define CPP_PROGRAMMINGPROJECT_REPLAY_H
+
+#include "GameSession.h"
+#include <array>
+
+/*
+ * Replay files record the inputs given to a GameSession, so that a run can be played back exactly. A GameSession is
+ * deterministic given its seed, window size and the inputs of each step, so only changes to the inputs are stored.
+ *
+ * Layout: the magic "SRPL", a version byte, then the header values (seed, window width, window height, endless) as
+ * varints. This is followed by events, each a varint of (ticks since the previous event << 3 | event type), where
+ * LEVEL and END events are followed by a varint value. Ticks count calls to GameSession::Step.
+ */
+enum ReplayEventType {
+    REPLAY_JUMP_DOWN = 0,
+    REPLAY_JUMP_UP = 1,
+    REPLAY_PAUSE_DOWN = 2,
+    REPLAY_PAUSE_UP = 3,
+    REPLAY_RESUME_DOWN = 4,
+    REPLAY_RESUME_UP = 5,
+    REPLAY_LEVEL = 6,                                                                                                   // value is the difficulty of the new level
+    REPLAY_END = 7,                                                                                                     // value is the final score
+};
+
+struct ReplayHeader {
+    unsigned int seed = 0;
+    int windowWidth = 0, windowHeight = 0;
+    bool endless = false;
+};
+
+class ReplayWriter {
+    private:
+        std::ofstream file {};
+        std::vector<uint8_t> buffer {};                                                                                 // written to the file once full
+        Uint64 bytesWritten = 0;
+        Uint64 lastTick = 0;                                                                                            // tick of the last event
+        SessionInputs lastInputs {};
+        int lastDifficulty = -1;
+
+        void WriteVarint(Uint64 value);
+        void WriteEvent(Uint64 tick, ReplayEventType type);
+        void Flush();
+
+    public:
+        static const size_t BUFFER_SIZE = 4096;
+
+        ~ReplayWriter();
+
+        bool Open(const std::string& path, const ReplayHeader& header, std::string& error);
+        bool IsOpen() const;
+
+        // Record the inputs before the step of tick, then the difficulty after it
+        void RecordInputs(Uint64 tick, const SessionInputs& inputs);
+        void RecordDifficulty(Uint64 tick, int difficulty);
+        void Finish(Uint64 tick, int score);
+
+        Uint64 GetBytesWritten() const;
+};
+
+class ReplayReader {
+    private:
+        std::ifstream file {};
+        std::array<uint8_t, 4096> buffer {};                                                                            // replays are read in blocks, never held whole
+        size_t bufferPos = 0, bufferEnd = 0;
+        ReplayHeader header {};
+
+        // next event not yet applied
+        Uint64 eventTick = 0;
+        ReplayEventType eventType = REPLAY_END;
+        Uint64 eventValue = 0;
+        bool eventPending = false;
+
+        SessionInputs inputs {};
+        int difficulty = -1;
+        bool ended = false;
+        Uint64 endTick = 0;
+        int finalScore = 0;
+        std::string error {};
+
+        bool ReadByte(uint8_t& byte);
+        bool ReadVarint(Uint64& value);
+        void ReadEvent();
+
+    public:
+        bool Open(const std::string& path, std::string& openError);
+        const ReplayHeader& GetHeader() const;
+
+        // Applies the events up to and including tick, returning the inputs for the step of tick
+        const SessionInputs& InputsAt(Uint64 tick);
+        int GetDifficulty() const;
+        bool Ended(Uint64 tick) const;
+        Uint64 GetEndTick() const;
+        int GetFinalScore() const;
+        const std::string& GetError() const;
+};
+
+// Result of playing a replay through a GameSession without a window
+struct ReplayResult {
+    Uint64 ticks = 0;
+    int score = 0;
+    bool desynced = false;                                                                                              // the session did not follow the recording
+    std::string reason {};
+    double seconds = 0;
+};
+
+ReplayResult PlayReplayHeadless(ReplayReader& replay);
+
+#endif //CPP_PROGRAMMINGPROJECT_REPLAY_H
@@ -0,0 +1,138 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#include "SimulationThread.h"
+#include "Profiler.h"
+#include "Trace.h"
+
+RenderState FrameSnapshot::Interpolate(Uint64 counter) const {
+    /*
+     * Returns the display state interpolated between the states before and after the last step, by the wall time that
+     * has not been simulated. Once a further step is due the current state is returned, rather than running ahead.
+     */
+    double sincePublished = (counter > publishedAt) ? double(counter - publishedAt) : 0;
+    double elapsedMs = leftoverMs + sincePublished * 1000.0 / double(SDL_GetPerformanceFrequency());
+    double alpha = std::min(elapsedMs / double(GameSession::SIM_TICK), 1.0);
+
+    RenderState state;
+    state.cameraX = prevState.cameraX + (currState.cameraX - prevState.cameraX) * alpha;
+    state.playerx = prevState.playerx + (currState.playerx - prevState.playerx) * alpha;
+    state.playery = prevState.playery + (currState.playery - prevState.playery) * alpha;
+    return state;
+}
+
+
+
+
+
+SimulationThread::SimulationThread(GameSession& gameSession, ReplayWriter& replayWriter, ReplayReader* replayReader) :
+        session(gameSession),
+        recorder(replayWriter),
+        replay(replayReader) {
+}
+
+SimulationThread::~SimulationThread() {
+    Stop();
+}
+
+void SimulationThread::Start() {
+    // The first snapshot is published before the thread starts, so the render thread always has one to display
+    PublishSnapshot(0, SDL_GetPerformanceCounter(), session.GameOver());
+    running = true;
+    thread = std::thread(&SimulationThread::Run, this);
+}
+
+void SimulationThread::Stop() {
+    running = false;
+    if (thread.joinable()) thread.join();
+}
+
+void SimulationThread::Run() {
+    /*
+     * Accumulates wall time and steps the session whenever a SIM_TICK of it is due, publishing a snapshot after each
+     * batch of steps, then sleeps until the next step is due. A late wake up is caught up on by the next batch, up to
+     * MAX_FRAME_TIME.
+     */
+    TRACE_THREAD_NAME("simulation");
+    const double counterPerMs = double(SDL_GetPerformanceFrequency()) / 1000.0;
+    const double simTick = double(GameSession::SIM_TICK);
+    Uint64 prevCounter = SDL_GetPerformanceCounter();
+    double accumulator = 0;                                                                                             // wall time (ms) not yet simulated
+    bool finished = false;
+
+    while (running.load(std::memory_order_relaxed) && !finished) {
+        Uint64 counter = SDL_GetPerformanceCounter();
+        accumulator += double(counter - prevCounter) / counterPerMs;
+        accumulator = std::min(accumulator, double(GameSession::MAX_FRAME_TIME));                                       // prevent a hitch causing a spiral of catch-up steps
+        prevCounter = counter;
+
+        if (accumulator >= simTick) {
+            while (accumulator >= simTick && !session.GameOver()) {
+                SessionInputs inputs;
+                inputs.jumpHeld = jumpHeld.load(std::memory_order_relaxed);
+                inputs.pausePressed = pausePressed.load(std::memory_order_relaxed);
+                inputs.resumePressed = resumePressed.load(std::memory_order_relaxed);
+                if (replay) {
+                    inputs = replay->InputsAt(tick);
+                    if (replay->Ended(tick)) break;
+                }
+
+                recorder.RecordInputs(tick, inputs);
+                {
+                    PROFILE_SCOPE(PROFILE_SIMULATION);
+                    session.Step(inputs);
+                }
+                recorder.RecordDifficulty(tick, session.GetDifficulty());
+                accumulator -= simTick;
+                tick++;
+            }
+
+            finished = session.GameOver() || (replay && replay->Ended(tick));
+            PublishSnapshot(accumulator, counter, finished);
+        }
+
+        double untilNextStep = simTick - accumulator;
+        if (!finished && untilNextStep > 0) {
+            std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(untilNextStep));
+        }
+    }
+}
+
+void SimulationThread::PublishSnapshot(double leftoverMs, Uint64 counter, bool finished) {
+    // Called on the simulation thread, or before it starts
+    FrameSnapshot& snapshot = snapshots.Back();
+    snapshot.tick = tick;
+    snapshot.prevState = session.GetRenderState(0);
+    snapshot.currState = session.GetRenderState(1);
+    snapshot.leftoverMs = leftoverMs;
+    snapshot.publishedAt = counter;
+    snapshot.score = session.GetCollectables().GetScore();
+    snapshot.lives = session.GetPlayer().GetLives();
+    snapshot.difficulty = session.GetDifficulty();
+    snapshot.levelsConstructed = session.GetLevelsConstructed();
+    snapshot.paused = session.IsPaused();
+    snapshot.finished = finished;
+    snapshot.playerSize = session.GetPlayer().GetPlayerWidthHeight();
+    session.CaptureViews(snapshot.track, snapshot.items);
+    snapshots.Publish();
+}
+
+
+
+
+
+void SimulationThread::SetInputs(const SessionInputs& inputs) {
+    jumpHeld.store(inputs.jumpHeld, std::memory_order_relaxed);
+    pausePressed.store(inputs.pausePressed, std::memory_order_relaxed);
+    resumePressed.store(inputs.resumePressed, std::memory_order_relaxed);
+}
+
+const FrameSnapshot& SimulationThread::GetSnapshot() {
+    snapshots.Acquire();
+    return snapshots.Front();
+}
+
+Uint64 SimulationThread::GetTick() const {
+    return tick;
+}
@@ -0,0 +1,81 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#ifndef CPP_PROGRAMMINGPROJECT_SIMULATIONTHREAD_H
+#define CPP_PROGRAMMINGPROJECT_SIMULATIONTHREAD_H
+
+#include "GameCore.h"
+#include "GameSession.h"
+#include "Replay.h"
+#include "TripleBuffer.h"
+#include <atomic>
+#include <thread>
+
+// The state of a session after a batch of steps, published by the simulation thread for the render thread
+struct FrameSnapshot {
+    Uint64 tick = 0;                                                                                                    // steps taken by the session
+    RenderState prevState {};                                                                                           // before and after the last step
+    RenderState currState {};
+    double leftoverMs = 0;                                                                                              // wall time not yet simulated when published
+    Uint64 publishedAt = 0;                                                                                             // performance counter the leftover was measured at
+    int score = 0;
+    int lives = 0;
+    int difficulty = 0;
+    int levelsConstructed = 0;                                                                                          // level the states are of
+    bool paused = false;
+    bool finished = false;                                                                                              // game over, or the end of the replay
+    Size2D playerSize {};
+    TrackView track {};                                                                                                 // parts of the track and items around the camera
+    ItemsView items {};
+
+    RenderState Interpolate(Uint64 counter) const;
+};
+
+/*
+ * Steps a GameSession in fixed SIM_TICK steps on its own thread, so a slow frame or a vsync wait on the render thread
+ * does not hold up the simulation. The render thread samples the inputs, which the simulation applies to every step
+ * until they are next set, and displays the latest FrameSnapshot, read from a TripleBuffer so neither thread waits.
+ *
+ * Each snapshot holds views of the track and items around the camera, so the render thread displays the game from the
+ * snapshot alone and never reads the session, which is only used by the simulation thread whilst it runs. The views
+ * reuse the vectors of the snapshot they are captured into, so publishing allocates nothing once all three snapshots
+ * have grown to fit. SDL is only called from the render thread, which holds every texture.
+ */
+class SimulationThread {
+    private:
+        GameSession& session;
+        ReplayWriter& recorder;
+        ReplayReader* replay;                                                                                           // inputs are played back from this if given
+
+        std::thread thread {};
+        std::atomic<bool> running {false};
+        TripleBuffer<FrameSnapshot> snapshots {};
+        Uint64 tick = 0;
+
+        // inputs last sampled by the render thread
+        std::atomic<bool> jumpHeld {false};
+        std::atomic<bool> pausePressed {false};
+        std::atomic<bool> resumePressed {false};
+
+        void Run();
+        void PublishSnapshot(double leftoverMs, Uint64 counter, bool finished);
+
+    public:
+        SimulationThread(GameSession& gameSession, ReplayWriter& replayWriter, ReplayReader* replayReader = nullptr);
+        ~SimulationThread();
+        SimulationThread(const SimulationThread&) = delete;
+        SimulationThread& operator=(const SimulationThread&) = delete;
+
+        void Start();
+        void Stop();
+
+        // Render thread
+        void SetInputs(const SessionInputs& inputs);
+        const FrameSnapshot& GetSnapshot();                                                                             // valid until the next call
+
+        // Getters, once stopped
+        Uint64 GetTick() const;
+};
+
+#endif //CPP_PROGRAMMINGPROJECT_SIMULATIONTHREAD_H
@@ -0,0 +1,74 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#include "SpriteBatch.h"
+
+SpriteBatch::TextureBatch& SpriteBatch::GetBatch(SDL_Texture* texture) {
+    // A layer only uses a few textures, so they are searched in order
+    for (size_t b = 0; b < usedBatches; b++) {
+        if (batches[b].texture == texture) return batches[b];
+    }
+
+    if (usedBatches == batches.size()) batches.emplace_back();
+    TextureBatch& batch = batches[usedBatches++];
+    batch.texture = texture;
+
+    int width = 1, height = 1;
+    SDL_QueryTexture(texture, nullptr, nullptr, &width, &height);
+    batch.width = float(std::max(width, 1));
+    batch.height = float(std::max(height, 1));
+    return batch;
+}
+
+void SpriteBatch::Add(SDL_Texture* texture, const SDL_Rect* srcRect, const SDL_Rect& destRect) {
+    if (texture == nullptr) return;                                                                                     // not drawn, as with SDL_RenderCopy
+    if (!batching) {
+        sprites.push_back({texture, srcRect != nullptr, srcRect ? *srcRect : SDL_Rect {}, destRect});
+        return;
+    }
+
+    // Two triangles covering destRect, with texture coordinates covering srcRect (or the whole texture)
+    TextureBatch& batch = GetBatch(texture);
+    float u1 = 0, v1 = 0, u2 = 1, v2 = 1;
+    if (srcRect != nullptr) {
+        u1 = float(srcRect->x) / batch.width;
+        v1 = float(srcRect->y) / batch.height;
+        u2 = float(srcRect->x + srcRect->w) / batch.width;
+        v2 = float(srcRect->y + srcRect->h) / batch.height;
+    }
+
+    float x1 = float(destRect.x), y1 = float(destRect.y);
+    float x2 = float(destRect.x + destRect.w), y2 = float(destRect.y + destRect.h);
+    const SDL_Color white {255, 255, 255, 255};
+
+    int first = int(batch.vertices.size());
+    batch.vertices.push_back({{x1, y1}, white, {u1, v1}});
+    batch.vertices.push_back({{x2, y1}, white, {u2, v1}});
+    batch.vertices.push_back({{x1, y2}, white, {u1, v2}});
+    batch.vertices.push_back({{x2, y2}, white, {u2, v2}});
+
+    const int quad[] = {0, 1, 2, 2, 1, 3};
+    for (int index : quad) batch.indices.push_back(first + index);
+}
+
+void SpriteBatch::Flush(Renderer& renderer) {
+    // Submits the sprites added since the last flush
+    for (const Sprite& sprite : sprites) {
+        renderer.Copy(sprite.texture, sprite.hasSrcRect ? &sprite.srcRect : nullptr, sprite.destRect);
+    }
+    sprites.clear();
+
+    for (size_t b = 0; b < usedBatches; b++) {
+        TextureBatch& batch = batches[b];
+        renderer.Geometry(batch.texture, batch.vertices.data(), int(batch.vertices.size()), batch.indices.data(),
+                          int(batch.indices.size()));
+        batch.vertices.clear();
+        batch.indices.clear();
+    }
+    usedBatches = 0;
+}
+
+void SpriteBatch::SetBatching(bool enabled) {
+    batching = enabled;
+}
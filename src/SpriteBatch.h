@@ -0,0 +1,48 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#ifndef CPP_PROGRAMMINGPROJECT_SPRITEBATCH_H
+#define CPP_PROGRAMMINGPROJECT_SPRITEBATCH_H
+
+#include "GameCore.h"
+#include "Renderer.h"
+
+/*
+ * Collects the sprites of one layer of the display, such as the track or the items, and submits them with one
+ * Renderer::Geometry call per texture. Each texture's quads are drawn in the order they were added, and the textures in
+ * the order they were first added, so sprites only move in front of one another if they share a texture with a sprite
+ * added earlier. Buffers are kept between flushes, so a batch allocates nothing once it has grown to fit a layer.
+ */
+class SpriteBatch {
+    private:
+        struct TextureBatch {
+            SDL_Texture* texture = nullptr;
+            float width = 1, height = 1;                                                                                // to normalise texture coordinates
+            std::vector<SDL_Vertex> vertices {};
+            std::vector<int> indices {};
+        };
+
+        struct Sprite {
+            SDL_Texture* texture;
+            bool hasSrcRect;
+            SDL_Rect srcRect;
+            SDL_Rect destRect;
+        };
+
+        std::vector<TextureBatch> batches {};                                                                           // includes unused batches kept from earlier flushes
+        size_t usedBatches = 0;
+        std::vector<Sprite> sprites {};                                                                                 // in order, when batching is disabled
+        bool batching = true;
+
+        TextureBatch& GetBatch(SDL_Texture* texture);
+
+    public:
+        void Add(SDL_Texture* texture, const SDL_Rect* srcRect, const SDL_Rect& destRect);
+        void Flush(Renderer& renderer);
+
+        // Sprites are copied one at a time in the order they were added if disabled, for comparison
+        void SetBatching(bool enabled);
+};
+
+#endif //CPP_PROGRAMMINGPROJECT_SPRITEBATCH_H
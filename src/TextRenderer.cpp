@@ -0,0 +1,107 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#include "TextRenderer.h"
+#include "Renderer.h"
+
+GlyphAtlas::GlyphAtlas(AssetCache& assets, TTF_Font* font) {
+    /*
+     * Renders each glyph of the font and packs them left to right into rows of the atlas, starting a new row when the
+     * next glyph would pass MAX_ATLAS_WIDTH. All glyphs are the height of the font, so rows are lineHeight tall.
+     */
+    if (font == nullptr) return;
+    lineHeight = TTF_FontHeight(font);
+
+    // render glyphs and determine their position in the atlas
+    std::array<SDL_Surface*, LAST_GLYPH - FIRST_GLYPH + 1> glyphSurfaces {};
+    int x = 0, y = 0, atlasWidth = 0;
+    for (int g = FIRST_GLYPH; g <= LAST_GLYPH; g++) {
+        SDL_Surface* glyphSurface = TTF_RenderGlyph_Blended(font, Uint16(g), {255, 255, 255, 255});
+        int w = (glyphSurface != nullptr) ? glyphSurface->w : 0;
+        if (glyphSurface == nullptr) TTF_GlyphMetrics(font, Uint16(g), nullptr, nullptr, nullptr, nullptr, &w);
+
+        if (x + w > MAX_ATLAS_WIDTH) {                                                                                  // start new row
+            x = 0;
+            y += lineHeight;
+        }
+
+        glyphSurfaces[g - FIRST_GLYPH] = glyphSurface;
+        glyphRects[g - FIRST_GLYPH] = {x, y, w, lineHeight};
+        x += w;
+        atlasWidth = std::max(atlasWidth, x);
+    }
+
+    // copy glyphs into the atlas, replacing rather than blending so the glyph alpha is kept
+    SDL_Surface* atlasSurface = SDL_CreateRGBSurfaceWithFormat(0, std::max(1, atlasWidth), y + lineHeight, 32,
+                                                               SDL_PIXELFORMAT_RGBA32);
+    for (int g = 0; g < int(glyphSurfaces.size()); g++) {
+        if (glyphSurfaces[g] == nullptr) continue;
+        SDL_Rect dest = glyphRects[g];
+        SDL_SetSurfaceBlendMode(glyphSurfaces[g], SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(glyphSurfaces[g], nullptr, atlasSurface, &dest);
+        SDL_FreeSurface(glyphSurfaces[g]);
+    }
+
+    atlasTexture = assets.CreateTextureFromSurface(atlasSurface);
+    SDL_FreeSurface(atlasSurface);
+}
+
+const SDL_Rect* GlyphAtlas::GetGlyph(char glyph) const {
+    // glyphs outside of the atlas are drawn as '?'
+    int g = (unsigned char)glyph;
+    if (g < FIRST_GLYPH || g > LAST_GLYPH) g = '?';
+    return &glyphRects[g - FIRST_GLYPH];
+}
+
+
+
+
+
+int GlyphAtlas::GetLineHeight() const {
+    return lineHeight;
+}
+
+int GlyphAtlas::MeasureWidth(const char* text) const {
+    // width of the text at the point size of the atlas
+    int width = 0;
+    for (const char* glyph = text; *glyph != '\0'; glyph++) {
+        width += GetGlyph(*glyph)->w;
+    }
+    return width;
+}
+
+int GlyphAtlas::MeasureWidth(const char* text, int height) const {
+    // width of the text when scaled to the given height, keeping its w:h ratio
+    if (lineHeight == 0) return 0;
+    return int(MeasureWidth(text) * (double(height) / lineHeight));
+}
+
+int GlyphAtlas::MeasureWidth(const std::string& text, int height) const {
+    return MeasureWidth(text.c_str(), height);
+}
+
+void GlyphAtlas::Draw(Renderer& renderer, const char* text, const SDL_Rect& destRect) const {
+    /*
+     * Draws the text stretched to fill destRect, in the same way as copying a texture of the rendered text to
+     * destRect would. Each glyph is one copy from the atlas.
+     */
+    int textWidth = MeasureWidth(text);
+    if (textWidth == 0) return;
+    double scalex = double(destRect.w) / textWidth;
+
+    int advance = 0;
+    for (const char* glyph = text; *glyph != '\0'; glyph++) {
+        const SDL_Rect* srcRect = GetGlyph(*glyph);
+        int x1 = destRect.x + int(advance * scalex);
+        int x2 = destRect.x + int((advance + srcRect->w) * scalex);                                                     // from the next glyph's position so no gaps
+        SDL_Rect glyphRect = {x1, destRect.y, x2 - x1, destRect.h};
+
+        renderer.Copy(atlasTexture.get(), srcRect, glyphRect);
+        advance += srcRect->w;
+    }
+}
+
+void GlyphAtlas::Draw(Renderer& renderer, const std::string& text, const SDL_Rect& destRect) const {
+    Draw(renderer, text.c_str(), destRect);
+}
@@ -0,0 +1,41 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#ifndef CPP_PROGRAMMINGPROJECT_TEXTRENDERER_H
+#define CPP_PROGRAMMINGPROJECT_TEXTRENDERER_H
+
+#include "GameCore.h"
+#include "AssetCache.h"
+#include <array>
+
+/*
+ * A single texture holding every printable ASCII glyph of a font at one point size, rasterised once when the atlas is
+ * created. Text is then drawn as a copy of each glyph's sub-rect, so changing text needs no rasterising or texture
+ * creation. Atlases are shared through AssetCache::GetGlyphAtlas.
+ */
+class GlyphAtlas {
+    private:
+        static const int FIRST_GLYPH = 32;                                                                              // ' '
+        static const int LAST_GLYPH = 126;                                                                              // '~'
+        static const int MAX_ATLAS_WIDTH = 2048;
+
+        TextureHandle atlasTexture {};
+        std::array<SDL_Rect, LAST_GLYPH - FIRST_GLYPH + 1> glyphRects {};                                               // position of each glyph in the atlas
+        int lineHeight = 0;
+
+        const SDL_Rect* GetGlyph(char glyph) const;
+
+    public:
+        GlyphAtlas(AssetCache& assets, TTF_Font* font);
+
+        int GetLineHeight() const;
+        int MeasureWidth(const char* text) const;
+        int MeasureWidth(const char* text, int height) const;
+        int MeasureWidth(const std::string& text, int height) const;
+        void Draw(Renderer& renderer, const char* text, const SDL_Rect& destRect) const;
+        void Draw(Renderer& renderer, const std::string& text, const SDL_Rect& destRect) const;
+};
+
+
+#endif //CPP_PROGRAMMINGPROJECT_TEXTRENDERER_H
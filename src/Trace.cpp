@@ -0,0 +1,105 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#include "Trace.h"
+
+#ifdef ENABLE_TRACING
+
+Tracer& Tracer::Get() {
+    static Tracer tracer;
+    return tracer;
+}
+
+uint32_t Tracer::ThreadId() {
+    // Small ids in order of first use, which read better in the trace viewer than native thread ids
+    static std::atomic<uint32_t> nextThreadId {1};
+    thread_local uint32_t threadId = nextThreadId.fetch_add(1);
+    return threadId;
+}
+
+void Tracer::Start(size_t capacity) {
+    // Allocates the ring and begins recording, events before this are not kept
+    ring.assign(capacity, TraceEvent {});
+    nextEvent = 0;
+    origin = std::chrono::steady_clock::now();
+    recording = true;
+}
+
+void Tracer::Record(const char* name, const char* category, std::chrono::steady_clock::time_point start,
+                    std::chrono::steady_clock::time_point end, int32_t value) {
+    if (!IsRecording()) return;
+
+    Uint64 index = nextEvent.fetch_add(1, std::memory_order_relaxed);
+    TraceEvent& event = ring[index % ring.size()];
+    event.name = name;
+    event.category = category;
+    event.startNs = Uint64(std::chrono::duration_cast<std::chrono::nanoseconds>(start - origin).count());
+    event.durationNs = Uint64(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    event.threadId = ThreadId();
+    event.value = value;
+}
+
+void Tracer::NameThread(const char* name) {
+    // Names the calling thread in the trace, later names for the same thread are ignored
+    std::lock_guard<std::mutex> lock(threadNamesMutex);
+    uint32_t threadId = ThreadId();
+    for (auto& threadName : threadNames) {
+        if (threadName.first == threadId) return;
+    }
+    threadNames.emplace_back(threadId, name);
+}
+
+
+
+
+
+bool Tracer::Write(const std::string& path) {
+    /*
+     * Stops recording and writes the events held in the ring to path, oldest first. This should be called once the
+     * threads being traced have stopped (or finished their work), so that no event is written to whilst it is read.
+     */
+    if (!IsRecording()) return false;
+    recording = false;
+
+    std::ofstream traceFile(path);
+    if (!traceFile.is_open()) {
+        printf("TRACE | ERROR: could not create %s\n", path.c_str());
+        return false;
+    }
+
+    Uint64 recorded = nextEvent.load();
+    Uint64 first = (recorded > ring.size()) ? recorded - ring.size() : 0;
+
+    // entries after the first are preceded by a comma
+    const char* separator = "";
+    traceFile << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    {
+        std::lock_guard<std::mutex> lock(threadNamesMutex);
+        for (auto& threadName : threadNames) {
+            traceFile << separator << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+                      << threadName.first << ",\"args\":{\"name\":\"" << threadName.second << "\"}}";
+            separator = ",";
+        }
+    }
+
+    char line[256];
+    for (Uint64 i = first; i < recorded; i++) {
+        const TraceEvent& event = ring[i % ring.size()];
+        int length = snprintf(line, sizeof(line),
+                              "%s\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,"
+                              "\"dur\":%.3f", separator, event.name, event.category, event.threadId,
+                              double(event.startNs) / 1000.0, double(event.durationNs) / 1000.0);
+        traceFile.write(line, std::min(length, int(sizeof(line)) - 1));
+        if (event.value != NO_VALUE) traceFile << ",\"args\":{\"value\":" << event.value << "}";
+        traceFile << "}";
+        separator = ",";
+    }
+    traceFile << "\n]}\n";
+
+    printf("TRACE | %llu events written to %s (%llu dropped as the ring was full)\n",
+           (unsigned long long)(recorded - first), path.c_str(), (unsigned long long)first);
+    return true;
+}
+
+#endif
@@ -0,0 +1,95 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#ifndef CPP_PROGRAMMINGPROJECT_TRACE_H
+#define CPP_PROGRAMMINGPROJECT_TRACE_H
+
+#include "GameCore.h"
+#include <atomic>
+#include <mutex>
+
+#ifdef ENABLE_TRACING
+
+// A timed section of one thread. Names and categories must be string literals, so recording does not copy them
+struct TraceEvent {
+    const char* name;
+    const char* category;
+    Uint64 startNs;                                                                                                     // since Tracer::Start
+    Uint64 durationNs;
+    uint32_t threadId;
+    int32_t value;                                                                                                      // shown as args.value if not NO_VALUE
+};
+
+/*
+ * Records TraceEvents from any thread into a ring buffer that is allocated by Start, so recording only costs an
+ * atomic increment and a copy into the ring. Once full, the oldest events are overwritten. Write exports the events
+ * as Chrome trace event JSON, which can be opened in chrome://tracing or ui.perfetto.dev.
+ */
+class Tracer {
+    private:
+        std::vector<TraceEvent> ring {};
+        std::atomic<Uint64> nextEvent {0};
+        std::atomic<bool> recording {false};
+        std::chrono::steady_clock::time_point origin {};
+
+        std::mutex threadNamesMutex {};
+        std::vector<std::pair<uint32_t, std::string>> threadNames {};
+
+    public:
+        static const int32_t NO_VALUE = INT32_MIN;
+        static const size_t DEFAULT_CAPACITY = 1 << 18;
+
+        static Tracer& Get();
+        static uint32_t ThreadId();
+
+        void Start(size_t capacity = DEFAULT_CAPACITY);
+        bool IsRecording() const {
+            return recording.load(std::memory_order_relaxed);
+        }
+        void Record(const char* name, const char* category, std::chrono::steady_clock::time_point start,
+                    std::chrono::steady_clock::time_point end, int32_t value = NO_VALUE);
+        void NameThread(const char* name);
+        bool Write(const std::string& path);
+};
+
+// Records the time from construction to destruction, if the tracer is recording
+class TraceScope {
+    private:
+        const char* name;
+        const char* category;
+        int32_t value;
+        bool active;
+        std::chrono::steady_clock::time_point start {};
+
+    public:
+        TraceScope(const char* eventName, const char* eventCategory, int32_t eventValue = Tracer::NO_VALUE)
+                : name(eventName), category(eventCategory), value(eventValue), active(Tracer::Get().IsRecording()) {
+            if (active) start = std::chrono::steady_clock::now();
+        }
+        ~TraceScope() {
+            if (active) Tracer::Get().Record(name, category, start, std::chrono::steady_clock::now(), value);
+        }
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(name, category) TraceScope TRACE_CONCAT(traceScope, __LINE__) {name, category}
+#define TRACE_SCOPE_VALUE(name, category, value) \
+    TraceScope TRACE_CONCAT(traceScope, __LINE__) {name, category, int32_t(value)}
+#define TRACE_THREAD_NAME(name) Tracer::Get().NameThread(name)
+#define TRACE_START() Tracer::Get().Start()
+#define TRACE_WRITE(path) Tracer::Get().Write(path)
+
+#else
+
+// Tracing disabled, scopes compile to nothing
+#define TRACE_SCOPE(name, category)
+#define TRACE_SCOPE_VALUE(name, category, value)
+#define TRACE_THREAD_NAME(name) ((void)0)
+#define TRACE_START() printf("TRACE | ERROR: built without ENABLE_TRACING\n")
+#define TRACE_WRITE(path) ((void)0)
+
+#endif
+
+#endif //CPP_PROGRAMMINGPROJECT_TRACE_H
@@ -3,71 +3,58 @@
 //
 
 #include "Track.h"
+#include "Trace.h"
+#include "Log.h"
 
 TrackObject::TrackObject(double x, double y, int w, int h) {
     objectStruct.Construct(x, y, w, h);
 }
 
-void TrackObject::CreateTexture(SDL_Renderer *RENDERER) {
-    // set texture
-    surface = IMG_Load(imgPath.c_str());
-    objectTexture = SDL_CreateTextureFromSurface(RENDERER, surface);
-    SDL_FreeSurface(surface);
-}
-
-void TrackObject::UpdateRect(Uint64 ELAPSED_TIME, double playerSpeed) {
-    objectStruct.rectx = objectStruct.gamex - (double(ELAPSED_TIME) * playerSpeed);
-}
-
-void TrackObject::Display(SDL_Renderer* RENDERER) {
-    if (!canDisplay) return;
-
-    int rectx = int(objectStruct.rectx - objectStruct.width/2.0);                                                       // set rect position to top left of desired model position
-    int recty = int(objectStruct.recty - objectStruct.height/2.0);
-    selfRect = {rectx, recty, objectStruct.width, objectStruct.height};
-
-    SDL_RenderCopy(RENDERER, objectTexture, nullptr, &selfRect);
-}
-
-bool TrackObject::PlayerCollision(Player player) const {
+bool TrackObject::PlayerCollision(const ObjectStruct& player) const {
     if (!collisionEnabled){
         return false;
     }
 
-    // get and store player position
-    std::vector<double> playerPosition = player.GetGamePosition();
-
     // check x distance is ! <= to player width
-    if (std::abs(objectStruct.gamex - playerPosition[0]) >
-    (player.GetPlayerWidthHeight()[0] / 2.0 + objectStruct.width / 2.0)) return false;
+    if (std::abs(objectStruct.gamex - player.gamex) > (player.width / 2.0 + objectStruct.width / 2.0)) return false;
 
     // check y distance is ! <= to player height
-    if (std::abs(objectStruct.gamey - playerPosition[1]) >
-    (player.GetPlayerWidthHeight()[1] / 2.0 + objectStruct.height / 2.0)) return false;
+    if (std::abs(objectStruct.gamey - player.gamey) > (player.height / 2.0 + objectStruct.height / 2.0)) return false;
 
     // hence player is in bounds
     return true;
 }
 
 
+bool TrackObject::CollisionEnabled() const {
+    return collisionEnabled;
+}
+
+bool TrackObject::CanDisplay() const {
+    return canDisplay;
+}
+
 ObjectStruct *TrackObject::GetStruct() {
     return &objectStruct;
 }
 
+const ObjectStruct *TrackObject::GetStruct() const {
+    return &objectStruct;
+}
+
 
 
 
 
 TrackObstacle::TrackObstacle(double x, double y, int w, int h) : TrackObject(x, y, w, h) {
-    imgPath = "../Resources/Images/TrackObstacles/Boulder.png";
 }
 
-bool TrackObstacle::PlayerCollided(Player &player) {
+bool TrackObstacle::PlayerCollided(const ObjectStruct& player) {
     if (!PlayerCollision(player)) {
         return false;
     }
 
-    printf("ACTIVATING PLAYER COLLISION RESPONSE\n");
+    LOG_INFO("OBSTACLE | player collided at x: %f", objectStruct.gamex);
     canDisplay = false;                                                                                                 // prevent obstacle from remaining as a constant hinderance to player
     collisionEnabled = false;                                                                                           // by hiding it and preventing future collisions to be detected
 
@@ -85,22 +72,26 @@ void TrackObstacle::SetTrackIndex(int index) {
 
 
 
-Track::Track(int MIN_TRACK_HEIGHT, int MAX_TRACK_HEIGHT, int w, int h) {
+Track::Track(int MIN_TRACK_HEIGHT, int MAX_TRACK_HEIGHT, int w, int h, Arena* levelArena) :
+        trackSegments(ArenaAllocator<TrackSegment>(levelArena)),
+        trackObstacles(ArenaAllocator<TrackObstacle>(levelArena)),
+        tileTable(ArenaAllocator<TileInfo>(levelArena)) {
     TILE_WIDTH = w;
     TILE_HEIGHT = h;
 
     this->MIN_TRACK_HEIGHT = MIN_TRACK_HEIGHT;
     this->MAX_TRACK_HEIGHT = MAX_TRACK_HEIGHT;
 
-    // Initialise rect
-    trackRect = {0, 0, w, h};
-
     // Provide first trackSegment
     TrackSegment start;
-    start.gamex = start.rectx = w/2.0;
-    start.gamey = start.recty = MIN_TRACK_HEIGHT;
+    start.gamex = w/2.0;
+    start.gamey = MIN_TRACK_HEIGHT;
     start.trackIndex = 0;
     trackSegments.push_back(start);
+    lastSegment = start;
+    tileTable.resize(1);
+    tileTable[0].trackIndex = 0;
+    tileTable[0].segment = 0;
 }
 
 
@@ -108,58 +99,30 @@ Track::Track(int MIN_TRACK_HEIGHT, int MAX_TRACK_HEIGHT, int w, int h) {
 
 
 void Track::ObtainTrackGenInfo(int DIFFICULTY) {
-    sectionGenerationInfo.clear();                                                                                      // Empty previous generation info
-    std::fstream trackGenerationInfoFile("../RequiredFiles/GenerationPercs.txt");                 // open file to read gen info
-    std::string generationInfoLine;
-    std::string div = ", ";
-    unsigned long long pos;
-
-    // Find line housing the difficulty generation information
-    while (std::getline(trackGenerationInfoFile, generationInfoLine)) {                                           // while file is not empty
-        pos = generationInfoLine.find(div);                                                                         // find first instance of ', '
-        try {
-            if (std::stoi(generationInfoLine.substr(0, pos)) == DIFFICULTY) {                                // ignore all lines where first value does not match the difficulty value
-                generationInfoLine.erase(0, pos + div.length());                                                 // remove difficulty section
-                break;                                                                                                  // exit while early since difficulty is found
-            }
-        }
-        catch (std::exception &e) {                                                                                     // catches all lines where first value cannot be converted to string
-            printf("DIFFICULTY: %d. Not difficulty line, %s failed\n", DIFFICULTY, e.what());
-        }
-    }
-    trackGenerationInfoFile.close();
-
-    // obtain track generation info
-    while ((pos = generationInfoLine.find(div)) != std::string::npos) {                                             // while ', ' remains in the line
-        std::string generationInfo = generationInfoLine.substr(0, pos);
-
-        int infoValues[4] = {}, i = 0;
-        unsigned long long infoPos;
-        while ((infoPos = generationInfo.find(':')) != std::string::npos) {                                          // while ':' remains in the string
-            infoValues[i] = std::stoi(generationInfo.substr(0, infoPos));                                    // split segment info values stored in generationInfo string into array of ints
-            generationInfo.erase(0, infoPos+1);                                                                  // remove section from string
-            i++;
-        }
-
-        sectionGenerationInfo.emplace_back();
-        sectionGenerationInfo.back().Construct(infoValues[0], infoValues[1],
-                                               infoValues[2], infoValues[3]);
-
-        generationInfoLine.erase(0, pos + div.length());
-    }
+    // Fetch the generation rates for the difficulty, these are read from GenerationPercs.txt only once
+    generationProfile = &GenerationProfiles::Get().ForDifficulty(DIFFICULTY);
 }
 
 
 
 
 
-PossiblePosition Track::CreatePossiblePosition(TrackSegment prevSegment, int minLength, int maxLength) const {
+static Arena& GenerationScratch() {
+    // Scratch memory for the generation running on this thread, released as each use of it finishes
+    thread_local Arena scratch {16 * 1024};
+    return scratch;
+}
+
+PossiblePosition Track::CreatePossiblePosition(TrackSegment prevSegment, int minLength, int maxLength) {
     double verticalSpeed;                                                                                               // Jump speed of player
     double maxDy, minDy;                                                                                                // max and minimum change in y position (for the given deltaTicks)
     int dx;                                                                                                             // change in x position
     int deltaTicks;                                                                                                     // ticks taken to travel from end of prev section to mp of current tile
 
-    std::vector<PossiblePosition> possibleHeights {};                                                                   // houses all possible heights player can jump/fall to
+    Arena& scratch = GenerationScratch();
+    ArenaFrame frame (scratch);                                                                                         // possibleHeights is released on return
+    ArenaVector<PossiblePosition> possibleHeights {ArenaAllocator<PossiblePosition>(&scratch)};                         // houses all possible heights player can jump/fall to
+    possibleHeights.reserve(2 * std::max(0, maxLength - minLength + 1));                                                // at most a max and min height per length
 
     for (int sl = minLength; sl <= maxLength; sl++) {
         dx = int((sl) * TILE_WIDTH);
@@ -205,7 +168,7 @@ PossiblePosition Track::CreatePossiblePosition(TrackSegment prevSegment, int min
         return position;
     }
 
-    int ranPos = std::rand() % int(possibleHeights.size()) + 0;                                                         // construct track at random possible height
+    int ranPos = layoutRandom.Below(int(possibleHeights.size()));                                                       // construct track at random possible height
     position.x = (minLength == 1) ? prevSegment.gamex + TILE_WIDTH : possibleHeights[ranPos].x;                         // if minlength is 1, then no empty space between segments
     position.y = possibleHeights[ranPos].y;
 
@@ -216,87 +179,147 @@ PossiblePosition Track::CreatePossiblePosition(TrackSegment prevSegment, int min
 
 
 
-void Track::ConstructTrack(int DIFFICULTY) {
+void Track::SetGenerationSeed(unsigned int seed, int level) {
+    // Seed for the track's random streams, which must be set before the track is constructed
+    generationSeed = seed;
+    levelNumber = level;
+}
+
+RandomStream Track::CreateRandomStream(RandomSubsystem subsystem) const {
+    // Stream for a part of this level's generation. In endless mode the items use a stream shared by all chunks
+    return {generationSeed, levelDifficulty, subsystem, endless ? 0 : levelNumber};
+}
+
+void Track::ConstructTrack(int DIFFICULTY, int trackLength) {
+    TRACE_SCOPE_VALUE("ConstructTrack", "generation", DIFFICULTY);
     ObtainTrackGenInfo(DIFFICULTY);                                                                                     // Fetch generation rates for the difficulty level
-    endOfTrackIndex = 150 + DIFFICULTY * 20;                                                                            // Determine length of track
+    levelDifficulty = DIFFICULTY;
+    layoutRandom = CreateRandomStream(RANDOM_LAYOUT);                                                                   // layout is the same for the same seed and level
+    endOfTrackIndex = (trackLength > 0) ? trackLength : 150 + DIFFICULTY * 20;                                          // Determine length of track
     nextCheckpointPosition = 5000;                                                                                      // Determine first checkpoint position
 
+    endless = false;
     trackSegments.clear();                                                                                              // Empty out the previous track segments
     trackObstacles.clear();                                                                                             // Empty out the previous track obstacles
+    tileTable.clear();                                                                                                  // Empty out the previous tile lookup table
+    segmentsConstructed = 0;
     maxObstacles = 5 + DIFFICULTY;
 
+    // reserve the whole level up front, so the vectors are allocated once (from the level arena, if the track has one)
+    LevelCapacity capacity = EstimateCapacity(DIFFICULTY, endOfTrackIndex);
+    trackSegments.reserve(capacity.segments);
+    tileTable.reserve(capacity.tiles);
+    trackObstacles.reserve(capacity.obstacles);
+
     PossiblePosition nextPosition {};                                                                                   // Set initial position of track
     nextPosition.y = MIN_TRACK_HEIGHT;
     nextPosition.x = TILE_WIDTH / 2.0;
-    int sectionLength;
 
     ConstructSegment(nextPosition, 20, "start");                                              // Construct the starting zone of the track
 
     // ConstructRect the main gameplay body of the track
     while (trackSegments.size() < endOfTrackIndex) {
-        int rJumpVal = std::rand() % 100 + 0;
-        int rTrackVal = std::rand() % 100 + 0;
-
-        for (int i = 0; i < sectionGenerationInfo.size() - 2; i++) {                                                    // Determine which track segment to be generated next
-            if (sectionGenerationInfo[i].WithinGenBounds(rTrackVal)) {
-                int minLen = sectionGenerationInfo[i].minLen;
-                int maxLen = sectionGenerationInfo[i].maxLen;
-                sectionLength = std::rand() % (maxLen - minLen + 1) + minLen;
-            }
-        }
-
-        if (sectionGenerationInfo[4].WithinGenBounds(rJumpVal)) {                                              // determine if jump is to be generated before the segment and create possible position
-            nextPosition = CreatePossiblePosition(trackSegments.back(),
-                                                  sectionGenerationInfo[4].minLen,
-                                                  sectionGenerationInfo[4].maxLen);
-        } else {                                                                                                        // no jump to be generated, determine possible position without jump
-            nextPosition = CreatePossiblePosition(trackSegments.back(),
-                                                  1,
-                                                  sectionLength);
-        }
-
-        if (!ConstructSegment(nextPosition, sectionLength)) {
-            printf("FAILED TO PRODUCE SECTION | CURR SECTIONS : %zu\n", trackSegments.size());
-        }
+        GenerateSection();
     }
 
     startOfTrackIndex = trackSegments[20].trackIndex;                                                                   // fetch trackindex values of first and last tracks of the main body
     endOfTrackIndex = trackSegments[int(trackSegments.size()) - 1].trackIndex;
 
     // Construct the ending zone of the track
-    nextPosition.y = trackSegments.back().gamey;
-    printf("END | ex: %f, ey: %f\n", nextPosition.x, nextPosition.y);
-    printf("FINAL SIZE | %d\n", int(trackSegments.size()));
-    printf("GENERATED %zu OBSTACLES\n", trackObstacles.size());
+    nextPosition.x = lastSegment.gamex + TILE_WIDTH;
+    nextPosition.y = lastSegment.gamey;
+    LOG_INFO("TRACK | end x: %f, y: %f, segments: %d, obstacles: %zu", nextPosition.x, nextPosition.y,
+             int(trackSegments.size()), trackObstacles.size());
     ConstructSegment(nextPosition, 80, "end");
 }
 
+LevelCapacity Track::EstimateCapacity(int DIFFICULTY, int trackLength) {
+    /*
+     * Estimates the storage needed by a level from its length and the generation profile of its difficulty. Segments
+     * are bounded by the start and end zones, the body, and one section overshooting the body. Tiles also include the
+     * gaps left by jumps, which are estimated from the average jump and section lengths, with a margin.
+     */
+    const GenerationProfile& profile = GenerationProfiles::Get().ForDifficulty(DIFFICULTY);
+    if (trackLength <= 0) trackLength = 150 + DIFFICULTY * 20;
+
+    double averageSection = 0;
+    int longestSection = 0;
+    for (int type = SECTION_LONG; type <= SECTION_SINGLE; type++) {
+        const SectionInfo& section = profile.sections[type];
+        double chance = (section.maxGenBound - section.minGenBound) / 100.0;
+        averageSection += chance * (section.minLen + section.maxLen) / 2.0;
+        longestSection = std::max(longestSection, section.maxLen);
+    }
+
+    const SectionInfo& jump = profile.sections[SECTION_JUMP];
+    double jumpChance = (jump.maxGenBound - jump.minGenBound) / 100.0;
+    double gapsPerTile = jumpChance * (jump.minLen + jump.maxLen) / 2.0 / std::max(1.0, averageSection);
+
+    LevelCapacity capacity;
+    capacity.segments = 20 + trackLength + longestSection + 80;
+    capacity.tiles = int(capacity.segments * (1 + gapsPerTile * 1.25)) + jump.maxLen;
+    capacity.obstacles = 5 + DIFFICULTY;
+    return capacity;
+}
+
+void Track::GenerateSection() {
+    /*
+     * Generates the next section of the main body of the track after the last constructed segment. The section type
+     * and length, and if a jump precedes it, are chosen using the generation rates of the current difficulty.
+     */
+    int rJumpVal = layoutRandom.Below(100);
+    int rTrackVal = layoutRandom.Below(100);
+
+    // Determine which track segment to be generated next, through the profile's table of section type for each roll
+    const SectionInfo &trackSection = generationProfile->sections[generationProfile->SectionForRoll(rTrackVal)];
+    int sectionLength = layoutRandom.Below(trackSection.maxLen - trackSection.minLen + 1) + trackSection.minLen;
+
+    PossiblePosition nextPosition {};
+    const SectionInfo &jump = generationProfile->sections[SECTION_JUMP];
+    if (jump.WithinGenBounds(rJumpVal)) {                                                                               // determine if jump is to be generated before the segment and create possible position
+        nextPosition = CreatePossiblePosition(lastSegment,
+                                              jump.minLen,
+                                              jump.maxLen);
+    } else {                                                                                                            // no jump to be generated, determine possible position without jump
+        nextPosition = CreatePossiblePosition(lastSegment,
+                                              1,
+                                              sectionLength);
+    }
+
+    if (!ConstructSegment(nextPosition, sectionLength)) {
+        LOG_WARN("FAILED TO PRODUCE SECTION | CURR SECTIONS : %d", segmentsConstructed);
+    }
+}
+
 
 
 
 
 
 bool Track::ConstructSegment(PossiblePosition &fromPosition, int sectionLength, const std::string& sectionType) {
+    TRACE_SCOPE_VALUE("ConstructSegment", "generation", sectionLength);
     if (fromPosition.y == 0) {                                                                                          // no possible position so return failure
         return false;                                                                                                   // failed to make section
     }
 
-    printf("LENGTH %d | FROM POS x: %f, y: %f |", sectionLength, fromPosition.x, fromPosition.y);
+    // kept for the debug log, as fromPosition is moved on to the end of the section
+    double fromx = fromPosition.x, fromy = fromPosition.y;
+    double checkpointx = -1, obstaclex = -1;
 
     // Determine if checkpoint is to be made
     bool addCheckpoint = false;
-    if (trackSegments.back().gamex >= nextCheckpointPosition) {
+    if (segmentsConstructed > 0 && lastSegment.gamex >= nextCheckpointPosition) {                                       // no previous segment when constructing the start zone
         addCheckpoint = true;
         nextCheckpointPosition += 5000;
-        printf(" CHECKPOINT GEN AT x: %f |", fromPosition.x);
+        checkpointx = fromPosition.x;
     }
 
     // Determine if obstacle is to be made
     int obIndex = -1;
-    if (sectionGenerationInfo[5].WithinGenBounds(std::rand() % 100 + 0)) {
+    if (generationProfile->sections[SECTION_OBSTACLE].WithinGenBounds(layoutRandom.Below(100))) {
         // Determine section index
         if (!addCheckpoint && sectionType.empty() && maxObstacles > 0){
-            obIndex = std::rand() % (sectionLength) + 1;
+            obIndex = layoutRandom.Below(sectionLength) + 1;
             maxObstacles -= 1;
         }
     }
@@ -311,122 +334,217 @@ bool Track::ConstructSegment(PossiblePosition &fromPosition, int sectionLength,
         if (sectionType == "end") newTrack.endLevel = true;
         if (sectionType == "start") newTrack.startLevel = true;
         if (addCheckpoint) addCheckpoint = false;
+
+        // add tile to lookup table, tiles skipped over by a jump are left as gaps. In endless mode this overwrites the
+        // tile (and segment) one ring length behind
+        int slot = TileSlot(newTrack.trackIndex);
+        if (slot >= int(tileTable.size())) tileTable.resize(slot + 1);
+        TileInfo &tile = tileTable[slot];
+        if (tile.trackIndex != newTrack.trackIndex) tile = TileInfo {};
+        tile.trackIndex = newTrack.trackIndex;
+
         if (s == obIndex) {
             TrackObstacle newObstacle(newTrack.gamex, newTrack.gamey - TILE_HEIGHT,TILE_WIDTH, TILE_HEIGHT);// create new obstacle, set position and size
             newObstacle.SetTrackIndex(newTrack.trackIndex);
-            trackObstacles.push_back(newObstacle);
+            if (endless) {
+                trackObstacles[nextObstacleSlot] = newObstacle;
+                tile.obstacle = nextObstacleSlot;
+                nextObstacleSlot = (nextObstacleSlot + 1) % int(trackObstacles.size());
+            } else {
+                trackObstacles.push_back(newObstacle);
+                tile.obstacle = int(trackObstacles.size()) - 1;
+            }
 
-            printf(" OBSTACLE GEN AT x: %f |", newTrack.gamex);
+            obstaclex = newTrack.gamex;
         }
 
-        trackSegments.push_back(newTrack);
+        if (endless) {
+            if (tile.segment == -1) tile.segment = slot;
+            trackSegments[slot] = newTrack;
+        } else {
+            if (tile.segment == -1) tile.segment = int(trackSegments.size());
+            trackSegments.push_back(newTrack);
+        }
+
+        lastSegment = newTrack;
+        segmentsConstructed++;
     }
 
     fromPosition.y = MIN_TRACK_HEIGHT + 1;
-    fromPosition.x = trackSegments.back().gamex + TILE_WIDTH;
+    fromPosition.x = lastSegment.gamex + TILE_WIDTH;
 
-    printf("\n");
+    LOG_DEBUG("LENGTH %d | FROM POS x: %f, y: %f | CHECKPOINT GEN AT x: %f | OBSTACLE GEN AT x: %f", sectionLength,
+              fromx, fromy, checkpointx, obstaclex);
 
     return true;
 }
 
-void Track::UpdateTrackRects(Uint64 ELAPSED_TIME) {
-    // Update track rect values to display correctly
-    for (TrackSegment &trackSegment : trackSegments) {
-        trackSegment.rectx = trackSegment.gamex - (double(ELAPSED_TIME) * playerSpeed);
-    }
 
-    for (TrackObject &obstacle : trackObstacles) {
-        obstacle.UpdateRect(ELAPSED_TIME, playerSpeed);
-    }
-}
 
 
 
-bool Track::CheckForCollision(Player& player) {
-    for (TrackObstacle &obstacle : trackObstacles) {
-        if (obstacle.PlayerCollided(player)) return true;
-    }
+void Track::StartEndless(int DIFFICULTY) {
+    /*
+     * Sets up the track for endless mode. Instead of a whole level, the track body is generated in chunks of
+     * CHUNK_TILES tiles by StreamAhead as the camera moves. Tiles, segments and obstacles are held in fixed size ring
+     * buffers, so tiles more than RING_CHUNKS chunks behind are recycled and memory use does not grow. The difficulty
+     * increases every ENDLESS_CHUNKS_PER_DIFFICULTY chunks, using the rows of GenerationPercs.txt.
+     */
+    endless = true;
+    endlessDifficulty = DIFFICULTY;
+    levelDifficulty = DIFFICULTY;
+    layoutRandom = CreateRandomStream(RANDOM_LAYOUT);                                                                   // stream for the start of the track
+    chunksGenerated = 0;
+    nextCheckpointPosition = 5000;
+    ObtainTrackGenInfo(endlessDifficulty);
 
-    return false;
+    // allocate the rings once
+    int ringTiles = CHUNK_TILES * RING_CHUNKS;
+    tileTable.assign(ringTiles, TileInfo {});
+    trackSegments.assign(ringTiles, TrackSegment {});
+    trackObstacles.assign(ringTiles / 8, TrackObstacle {0, 0, TILE_WIDTH, TILE_HEIGHT});
+    nextObstacleSlot = 0;
+    segmentsConstructed = 0;
+
+    PossiblePosition nextPosition {};                                                                                   // Set initial position of track
+    nextPosition.y = MIN_TRACK_HEIGHT;
+    nextPosition.x = TILE_WIDTH / 2.0;
+    ConstructSegment(nextPosition, 20, "start");                                              // Construct the starting zone of the track
+
+    startOfTrackIndex = lastSegment.trackIndex + 1;
+    endOfTrackIndex = lastSegment.trackIndex;
 }
 
+void Track::GenerateChunk() {
+    // Generates sections until the track reaches the end of the next chunk, updating the difficulty of the chunk
+    TRACE_SCOPE_VALUE("GenerateChunk", "generation", chunksGenerated);
+    int difficulty = std::min(6, endlessDifficulty + chunksGenerated / ENDLESS_CHUNKS_PER_DIFFICULTY);
+    if (chunksGenerated % ENDLESS_CHUNKS_PER_DIFFICULTY == 0) ObtainTrackGenInfo(difficulty);
+    maxObstacles = (5 + difficulty) * CHUNK_TILES / 150;                                                                // same obstacle density as a level
+
+    // each chunk has its own stream, so a chunk is the same whatever was generated before it
+    layoutRandom = RandomStream(generationSeed, endlessDifficulty, RANDOM_LAYOUT, chunksGenerated + 1);
+
+    chunksGenerated++;
+    int chunkEnd = chunksGenerated * CHUNK_TILES;
+    while (lastSegment.trackIndex < chunkEnd) {
+        GenerateSection();
+    }
+}
 
+TileRange Track::StreamAhead(const Camera& camera) {
+    /*
+     * Generates chunks until the track extends a chunk beyond the right of the camera. Returns the range of newly
+     * generated track indexes, which is empty if no chunks were generated.
+     */
+    TileRange generated;
+    generated.first = lastSegment.trackIndex + 1;
+
+    int targetIndex = int((camera.x + camera.width) / TILE_WIDTH) + CHUNK_TILES;
+    while (endless && lastSegment.trackIndex < targetIndex) {
+        GenerateChunk();
+    }
 
+    generated.last = lastSegment.trackIndex;
+    endOfTrackIndex = lastSegment.trackIndex;
+    return generated;
+}
 
+TileRange Track::GetResidentRange() const {
+    // Returns the range of track indexes that are held in memory
+    TileRange resident;
+    resident.last = lastSegment.trackIndex;
+    resident.first = endless ? std::max(0, resident.last - int(tileTable.size()) + 1) : 0;
+    return resident;
+}
 
-void Track::CreateTextures(SDL_Renderer *RENDERER) {
-    // Create toplevel Texture
-    std::string trackToplevelPath = "../Resources/Images/Track/TrackToplevel.png";
-    surface = IMG_Load(trackToplevelPath.c_str());
-    toplevelTexture = SDL_CreateTextureFromSurface(RENDERER, surface);
-    SDL_FreeSurface(surface);
+bool Track::IsEndless() const {
+    return endless;
+}
 
-    // Create toplevel bg deco texture
-    std::string ttlBgDecoPath = "../Resources/Images/Track/TrackToplevelBGDeco.png";
-    surface = IMG_Load(ttlBgDecoPath.c_str());
-    ttlBgTexture = SDL_CreateTextureFromSurface(RENDERER, surface);
-    SDL_FreeSurface(surface);
+size_t Track::GetResidentBytes() const {
+    // memory allocated for the segments, obstacles and tile lookup table
+    return trackSegments.capacity() * sizeof(TrackSegment) + trackObstacles.capacity() * sizeof(TrackObstacle)
+           + tileTable.capacity() * sizeof(TileInfo);
+}
 
-    // Create track checkpoint deco texture
-    std::string checkpointImgPath = "../Resources/Images/Track/TrackToplevelCheckpointDeco.png";
-    surface = IMG_Load(checkpointImgPath.c_str());
-    ttlCheckpointTexture = SDL_CreateTextureFromSurface(RENDERER, surface);
-    SDL_FreeSurface(surface);
+int Track::TileSlot(int trackIndex) const {
+    // position of a track index within the tile lookup table, which wraps around in endless mode
+    return endless ? trackIndex % int(tileTable.size()) : trackIndex;
+}
 
-    // Create filler texture
-    std::string trackFillerPath = "../Resources/Images/Track/TrackFiller.png";
-    surface = IMG_Load(trackFillerPath.c_str());
-    trackFillerTexture = SDL_CreateTextureFromSurface(RENDERER, surface);
-    SDL_FreeSurface(surface);
+const TileInfo* Track::GetTile(int trackIndex) const {
+    // returns the lookup info for the track index, or nullptr if the tile is not held
+    if (trackIndex < 0) return nullptr;
+    int slot = TileSlot(trackIndex);
+    if (slot >= int(tileTable.size()) || tileTable[slot].trackIndex != trackIndex) return nullptr;
+    return &tileTable[slot];
+}
 
-    // Create background image texture
-    std::string backgroundPath = "../Resources/Images/Backgrounds/MainCaveBackground.png";
-    surface = IMG_Load(backgroundPath.c_str());
-    backgroundTexture = SDL_CreateTextureFromSurface(RENDERER, surface);
-    SDL_FreeSurface(surface);
+int Track::GetObstacleSlot(int trackIndex) const {
+    // returns the index into trackObstacles of the obstacle on the tile, or -1 if there is none
+    const TileInfo* tile = GetTile(trackIndex);
+    if (tile == nullptr || tile->obstacle == -1) return -1;
+    if (trackObstacles[tile->obstacle].GetTrackIndex() != trackIndex) return -1;                                        // obstacle slot has been recycled
+    return tile->obstacle;
+}
 
-    // Create obstacle textures
-    for (TrackObstacle &obstacle : trackObstacles) {
-        obstacle.CreateTexture(RENDERER);
+bool Track::CheckForCollision(const ObjectStruct& player) {
+    /*
+     * Obstacles are a tile wide and sit on a single tile, so only the obstacles on the tiles either side of the one the
+     * player is over can be overlapping. These are found through the tile lookup table, so the cost does not depend on
+     * the number of obstacles in the track.
+     */
+    int playerIndex = int(player.gamex / TILE_WIDTH);
+    for (int ti = playerIndex - 1; ti <= playerIndex + 1; ti++) {
+        int slot = GetObstacleSlot(ti);
+        if (slot != -1 && trackObstacles[slot].PlayerCollided(player)) return true;
     }
+    return false;
 }
 
-void Track::DisplayTrack(SDL_Renderer* RENDERER, SDL_Window* WINDOW) {
-    int xMax, yMax;
-    SDL_GetWindowSize(WINDOW, &xMax, &yMax);
 
-    for (TrackSegment trackSegment : trackSegments) {
-        // only display if track segment within window area
-        if (trackSegment.rectx > xMax + TILE_WIDTH/2.0 && trackSegment.rectx < 0 - TILE_WIDTH/2.0) return;
 
-        // display toplevel
-        trackRect.x = int(trackSegment.rectx - TILE_WIDTH/2.0);
-        trackRect.y = int(trackSegment.recty - TILE_HEIGHT/2.0);
-        SDL_RenderCopy(RENDERER, toplevelTexture, nullptr, &trackRect);
 
-        // display toplevel bg deco, switch to checkpoint deco if track is a checkpoint
-        SDL_Texture* toplevelDeco = (trackSegment.checkpoint) ? ttlCheckpointTexture : ttlBgTexture;
 
-        trackRect.y -= TILE_HEIGHT;
-        SDL_RenderCopy(RENDERER, toplevelDeco, nullptr, &trackRect);
-        trackRect.y += TILE_HEIGHT;
-
-        // Display track filler
-        while ((trackRect.y += TILE_HEIGHT) <= yMax  + TILE_HEIGHT/2.0) {
-            SDL_RenderCopy(RENDERER, trackFillerTexture, nullptr, &trackRect);
+void Track::CaptureView(TrackView& view, TileRange tiles) const {
+    /*
+     * Copies the columns of the given tiles, and the obstacles still displayed on them, into view. Only the tiles are
+     * visited, so the cost does not depend on the length of the track. Tiles not held by the track are captured as
+     * gaps.
+     */
+    view.endless = endless;
+    view.tileWidth = TILE_WIDTH;
+    view.tileHeight = TILE_HEIGHT;
+    view.maxTrackHeight = MAX_TRACK_HEIGHT;
+    view.resident = GetResidentRange();
+    view.tiles = tiles;
+    view.columns.clear();
+    view.obstacles.clear();
+
+    for (int ti = tiles.first; ti <= tiles.last; ti++) {
+        TrackColumn column;
+        const TileInfo* tile = GetTile(ti);
+        if (tile != nullptr && tile->segment != -1) {
+            const TrackSegment &trackSegment = trackSegments[tile->segment];
+            column.gamex = trackSegment.gamex;
+            column.gamey = trackSegment.gamey;
+            column.gap = false;
+            column.checkpoint = trackSegment.checkpoint;
         }
-    }
+        view.columns.push_back(column);
 
-    for (TrackObject &obstacle : trackObstacles) {
-        obstacle.Display(RENDERER);
+        int slot = GetObstacleSlot(ti);
+        if (slot == -1 || !trackObstacles[slot].CanDisplay()) continue;
+        view.obstacles.push_back(*trackObstacles[slot].GetStruct());
     }
 }
 
-void Track::DisplayBackground(SDL_Renderer* RENDERER, SDL_Window *WINDOW) {
-    SDL_GetWindowSize(WINDOW, &backgroundRect.w, &backgroundRect.h);
-
-    SDL_RenderCopy(RENDERER, backgroundTexture, nullptr, &backgroundRect);
+const TrackColumn& TrackView::GetColumn(int trackIndex) const {
+    // Column of a captured tile, tiles outside of those captured are gaps
+    static const TrackColumn gap {};
+    if (trackIndex < tiles.first || trackIndex > tiles.last) return gap;
+    return columns[trackIndex - tiles.first];
 }
 
 
@@ -434,25 +552,35 @@ void Track::DisplayBackground(SDL_Renderer* RENDERER, SDL_Window *WINDOW) {
 
 
 
-TrackSegment Track::GetTrackAtIndex(int trackIndex) {
-    if (trackIndex == -1) return trackSegments.back();
-    for (TrackSegment track : trackSegments) {
-        if (track.trackIndex == trackIndex) return track;
+const TrackSegment& Track::GetTrackAtIndex(int trackIndex) const {
+    /*
+     * Returns the trackSegment at the given track index through the tile lookup table. Index -1 returns the last
+     * segment of the track, and gaps or indexes outside of the track return the segment at startOfTrackIndex (or the
+     * last generated segment in endless mode, where the track body is not held from the start).
+     */
+    if (trackIndex == -1) return endless ? lastSegment : trackSegments.back();
+    const TileInfo* tile = GetTile(trackIndex);
+    if (tile != nullptr && tile->segment != -1) {
+        return trackSegments[tile->segment];
     }
-    return trackSegments[startOfTrackIndex];
+    return endless ? lastSegment : trackSegments[startOfTrackIndex];
 }
 
-std::vector<int> Track::GetTrackWidthHeight() {
+Size2D Track::GetTrackWidthHeight() const {
     return {TILE_WIDTH, TILE_HEIGHT};
 }
 
-bool Track::IsObstacleAtIndex(int trackIndex) {
-    return std::any_of(trackObstacles.begin(), trackObstacles.end(), [&trackIndex](TrackObstacle &obstacle){
-        return (obstacle.GetTrackIndex() == trackIndex);
-    });
+bool Track::IsObstacleAtIndex(int trackIndex) const {
+    return GetObstacleSlot(trackIndex) != -1;
+}
+
+bool Track::IsGapAtIndex(int trackIndex) const {
+    // true if there is no segment at the track index, as a jump skips over it or the track does not hold it
+    const TileInfo* tile = GetTile(trackIndex);
+    return tile == nullptr || tile->segment == -1;
 }
 
-std::vector<int> Track::GetTrackStartEndIndex() {
+TileRange Track::GetTrackStartEndIndex() const {
     return {startOfTrackIndex, endOfTrackIndex};
 }
 
@@ -7,6 +7,9 @@
 
 #include "GameCore.h"
 #include "Player.h"
+#include "GenerationProfiles.h"
+#include "Random.h"
+#include "Arena.h"
 
 class Player;
 
@@ -15,16 +18,15 @@ class Player;
 
 
 struct ObjectStruct {
-    // positional information
+    // positional information, displayed relative to the camera
     double gamex, gamey;
-    double rectx, recty;
 
     // size information
     int width, height;
 
     void Construct(double x, double y, int w, int h) {
-        gamex = x; rectx = x;
-        gamey = y; recty = y;
+        gamex = x;
+        gamey = y;
 
         width = w;
         height = h;
@@ -35,6 +37,17 @@ struct ObjectStruct {
 
 
 
+// The visible area of the game, objects are displayed at their game position minus the camera position
+struct Camera {
+    double x = 0;                                                                                                       // game x position of the left edge of the window
+    int width = 0;
+    int height = 0;
+};
+
+
+
+
+
 struct TrackSegment : public ObjectStruct{
     int trackIndex = 0;
 
@@ -53,12 +66,6 @@ struct TrackSegment : public ObjectStruct{
 
 class TrackObject {
     protected:
-        // SDL and display components
-        SDL_Texture* objectTexture {};
-        SDL_Rect selfRect {};
-        SDL_Surface* surface {};
-        std::string imgPath;
-
         // Struct
         ObjectStruct objectStruct{};
 
@@ -68,11 +75,11 @@ class TrackObject {
 
     public:
         TrackObject(double x, double y, int w, int h);
-        void CreateTexture(SDL_Renderer* RENDERER);
-        void UpdateRect(Uint64 ELAPSED_TIME, double playerSpeed);
-        void Display(SDL_Renderer* RENDERER);
-        bool PlayerCollision(Player player) const;
+        bool PlayerCollision(const ObjectStruct& player) const;
+        bool CollisionEnabled() const;
+        bool CanDisplay() const;
         ObjectStruct* GetStruct();
+        const ObjectStruct* GetStruct() const;
 };
 
 
@@ -84,11 +91,53 @@ class TrackObstacle : public TrackObject {
         int trackIndex = 0;
     public:
         TrackObstacle(double x, double y, int w, int h);
-        bool PlayerCollided(Player &player);
+        bool PlayerCollided(const ObjectStruct& player);
         int GetTrackIndex() const;
         void SetTrackIndex(int index);
 };
 
+// Dense per-tile lookup info, indexed by trackIndex
+struct TileInfo {
+    int trackIndex = -1;                                                                                                // track index stored in this entry, differs once recycled
+    int segment = -1;                                                                                                   // index into trackSegments, -1 if the tile is a gap
+    int obstacle = -1;                                                                                                  // index into trackObstacles, -1 if no obstacle on the tile
+};
+
+// Inclusive range of track indexes
+struct TileRange {
+    int first = 0;
+    int last = -1;
+};
+
+// Column of the track on a tile, as displayed
+struct TrackColumn {
+    double gamex = 0, gamey = 0;                                                                                        // centre of the toplevel tile
+    bool gap = true;                                                                                                    // no column on the tile
+    bool checkpoint = false;
+};
+
+// Copy of the part of a track around the camera, which is all that is needed to display it. The vectors are reused, so
+// capturing into the same view allocates nothing once they have grown to fit
+struct TrackView {
+    int level = 0;                                                                                                      // changes whenever the track is replaced
+    bool endless = false;
+    int tileWidth = 0, tileHeight = 0;
+    int maxTrackHeight = 0;
+    TileRange resident {};                                                                                              // tiles held by the track
+    TileRange tiles {};                                                                                                 // tiles captured, resident ones have a column
+    std::vector<TrackColumn> columns {};                                                                                // column of each captured tile, from tiles.first
+    std::vector<ObjectStruct> obstacles {};                                                                             // obstacles still displayed on the captured tiles
+
+    const TrackColumn& GetColumn(int trackIndex) const;
+};
+
+// Number of segments, tiles and obstacles reserved for a level, from its length and generation profile
+struct LevelCapacity {
+    int segments = 0;
+    int tiles = 0;                                                                                                      // includes the gaps left by jumps
+    int obstacles = 0;
+};
+
 // Determining possible position
 struct PossiblePosition {
     double x;
@@ -99,23 +148,6 @@ struct PossiblePosition {
 
 
 
-struct SectionInfo {
-    int minGenBound;
-    int maxGenBound;
-    int minLen;
-    int maxLen;
-
-    void Construct(int minGB, int maxGB, int minL, int maxL) {
-        minGenBound = minGB;
-        maxGenBound = maxGB;
-        minLen = minL;
-        maxLen = maxL;
-    }
-
-    bool WithinGenBounds(int rGenValue) const {
-        return (minGenBound <= rGenValue && rGenValue < maxGenBound);
-    }
-};
 
 
 
@@ -123,25 +155,23 @@ struct SectionInfo {
 
 class Track {
     private:
-        // SDL and display components
-        SDL_Texture* toplevelTexture {};
-        SDL_Texture* ttlBgTexture {};
-        SDL_Texture* trackFillerTexture {};
-        SDL_Texture* ttlCheckpointTexture {};
-        SDL_Texture* backgroundTexture {};
-        SDL_Rect trackRect {};
-        SDL_Rect backgroundRect {0, 0};
-        SDL_Surface* surface {};
         int TILE_WIDTH;
         int TILE_HEIGHT;
 
-        // Vectors housing trackSegments and track obstacles
-        std::vector<TrackSegment> trackSegments {};
-        std::vector<TrackObstacle> trackObstacles {};
+        // Vectors housing trackSegments and track obstacles, allocated from the level's arena if it has one
+        ArenaVector<TrackSegment> trackSegments;
+        ArenaVector<TrackObstacle> trackObstacles;
+        ArenaVector<TileInfo> tileTable;
         int maxObstacles = 5;
 
         // Track Section Generation info
-        std::vector<SectionInfo> sectionGenerationInfo {};
+        const GenerationProfile* generationProfile {};                                                                  // rates for the difficulty, owned by GenerationProfiles
+        TrackSegment lastSegment {};                                                                                    // most recently constructed trackSegment
+        int segmentsConstructed = 0;
+        unsigned int generationSeed = 0;
+        int levelNumber = 0;                                                                                            // levels played before this one in the session
+        int levelDifficulty = 0;
+        RandomStream layoutRandom {};
         int startOfTrackIndex = 0, endOfTrackIndex = 150;
         int nextCheckpointPosition = endOfTrackIndex / 3;
         int MIN_TRACK_HEIGHT, MAX_TRACK_HEIGHT;
@@ -151,29 +181,53 @@ class Track {
         double GRAVITY{};
         double playerSpeed{};
 
+        // Endless mode, where the vectors above are used as ring buffers holding RING_CHUNKS chunks of tiles
+        bool endless = false;
+        int endlessDifficulty = 0;
+        int chunksGenerated = 0;
+        int nextObstacleSlot = 0;
+
+        int TileSlot(int trackIndex) const;
+        const TileInfo* GetTile(int trackIndex) const;
+        int GetObstacleSlot(int trackIndex) const;
+        void GenerateSection();
+        void GenerateChunk();
+
     public:
-        Track(int MIN_TRACK_HEIGHT, int MAX_TRACK_HEIGHT, int w, int h);
+        static const int CHUNK_TILES = 128;                                                                             // tiles generated at a time in endless mode
+        static const int RING_CHUNKS = 8;                                                                               // chunks held in memory in endless mode
+        static const int ENDLESS_CHUNKS_PER_DIFFICULTY = 3;                                                             // chunks generated before the difficulty increases
+
+        Track(int MIN_TRACK_HEIGHT, int MAX_TRACK_HEIGHT, int w, int h, Arena* levelArena = nullptr);
+        static LevelCapacity EstimateCapacity(int DIFFICULTY, int trackLength = 0);
 
         // ConstructRect the track body
         void ObtainTrackGenInfo(int DIFFICULTY);
-        void ConstructTrack(int DIFFICULTY);
+        void ConstructTrack(int DIFFICULTY, int trackLength = 0);
         bool ConstructSegment(PossiblePosition &fromPosition, int sectionLength, const std::string& sectionType = "");
-        PossiblePosition CreatePossiblePosition(TrackSegment prevSegment, int minLength, int maxLength) const;
+        PossiblePosition CreatePossiblePosition(TrackSegment prevSegment, int minLength, int maxLength);
+        void SetGenerationSeed(unsigned int seed, int level);
+        RandomStream CreateRandomStream(RandomSubsystem subsystem) const;
+
+        // Endless streaming of the track body
+        void StartEndless(int DIFFICULTY);
+        TileRange StreamAhead(const Camera& camera);
+        TileRange GetResidentRange() const;
+        bool IsEndless() const;
+        size_t GetResidentBytes() const;
 
-        // Updates to rect and player collision detection
-        void UpdateTrackRects(Uint64 ELAPSED_TIME);
-        bool CheckForCollision(Player& player);
+        // Player collision detection
+        bool CheckForCollision(const ObjectStruct& player);
 
         // Display
-        void CreateTextures(SDL_Renderer* RENDERER);
-        void DisplayTrack(SDL_Renderer* RENDERER, SDL_Window* WINDOW);
-        void DisplayBackground(SDL_Renderer* RENDERER, SDL_Window* WINDOW);
+        void CaptureView(TrackView& view, TileRange tiles) const;
 
         // Getters
-        TrackSegment GetTrackAtIndex(int trackIndex);
-        std::vector<int> GetTrackStartEndIndex();
-        std::vector<int> GetTrackWidthHeight();
-        bool IsObstacleAtIndex(int trackIndex);
+        const TrackSegment& GetTrackAtIndex(int trackIndex) const;
+        TileRange GetTrackStartEndIndex() const;
+        Size2D GetTrackWidthHeight() const;
+        bool IsObstacleAtIndex(int trackIndex) const;
+        bool IsGapAtIndex(int trackIndex) const;
 
         // Setters
         void SetWidthHeight(int w, int h);
@@ -8,11 +8,9 @@
 
 
 Coin::Coin(double x, double y, int w, int h) : TrackObject(x, y, w, h) {
-    // set coin texture path
-    imgPath = "../Resources/Images/Coin/100Coin_ratio_1-1.png";
 }
 
-bool Coin::PlayerPickup(Player &player, int &scoreBoard) {
+bool Coin::PlayerPickup(const ObjectStruct& player, int &scoreBoard) {
     // This function defines specialised behaviour for coins when collision with the player is detected
     if (!PlayerCollision(player)) return false;
 
@@ -26,12 +24,10 @@ bool Coin::PlayerPickup(Player &player, int &scoreBoard) {
 
 
 Collectable::Collectable(double x, double y, int w, int h) : TrackObject(x, y, w, h) {
-    // set collectable texture path:
-    imgPath = "../Resources/Images/Coin/SpecialCoin_Star.png";
 }
 
 
-bool Collectable::PlayerPickup(Player &player, int &scoreBoard) {
+bool Collectable::PlayerPickup(const ObjectStruct& player, int &scoreBoard) {
     // this function defines specialised behaviour for collectables when collision with the player is detected
     if (!PlayerCollision(player)) return false;
 
@@ -50,69 +46,190 @@ bool Collectable::GetCollectedState() const {
 
 
 
-void ScoreCollectables::ConstructCoins(Track track) {
+ScoreCollectables::ScoreCollectables(Arena* levelArena) :
+        coins(ArenaAllocator<Coin>(levelArena)),
+        collectables(ArenaAllocator<Collectable>(levelArena)),
+        coinBounds(levelArena),
+        collectableBounds(levelArena) {
+}
+
+template <typename T>
+struct ItemRing {
+    // The items in order of gamex, read through the ring they are held in if ringSize is not 0
+    ArenaVector<T> &items;
+    size_t head, count, ringSize;
+
+    T& operator[](size_t index) const {
+        return items[ringSize == 0 ? index : (head + index) % ringSize];
+    }
+    T& front() const {
+        return (*this)[0];
+    }
+    size_t size() const {
+        return count;
+    }
+    bool empty() const {
+        return count == 0;
+    }
+};
+
+void ScoreCollectables::ConstructCoins(const Track& track) {
     /*
      * This function will attempt to place a coin on every trackSegment. There is a 25% chance of this succeeding,
      * at which point a coin object is created and positioned appx 3 TILE HEIGHTS above the track.
      */
-    coins = {};                                                                                                         // Empty coins vector to remove prev coins
-    int hCoin = track.GetTrackWidthHeight()[1];                                                                         // Determine w h of coins
+    coins.clear();                                                                                                      // Empty coins vector to remove prev coins
+    coinHead = coinRing = 0;
+    coinCursor = 0;
+    int hCoin = track.GetTrackWidthHeight().h;                                                                          // Determine w h of coins
     int wCoin = hCoin * 4/5;
 
     // Determine distance from track top level that coin sits at
-    int yDist = (track.GetTrackWidthHeight()[1] * 5/2) + (hCoin/2);
+    int yDist = (track.GetTrackWidthHeight().h * 5/2) + (hCoin/2);
 
-    // through each track index in the main body of the track
-    for (int ti = track.GetTrackStartEndIndex()[0]; ti < track.GetTrackStartEndIndex()[1]; ti++) {
-        TrackSegment trackSegment = track.GetTrackAtIndex(ti);
+    // coins are rolled by track index, so ConstructCoins and StreamCoins place the same coins on the same tiles
+    const RandomStream coinRandom = track.CreateRandomStream(RANDOM_COINS);
+
+    // the rolls can be read out of order, so they are counted first to allocate the coins once
+    TileRange body = track.GetTrackStartEndIndex();
+    int coinTotal = 0;
+    for (int ti = body.first; ti < body.last; ti++) {
+        if (!track.IsGapAtIndex(ti) && 25 > coinRandom.BelowAt(ti, 100)) coinTotal++;
+    }
+    coins.reserve(coinTotal);
+
+    // through each track index in the main body of the track, skipping the gaps
+    for (int ti = body.first; ti < body.last; ti++) {
+        if (track.IsGapAtIndex(ti)) continue;
+        const TrackSegment &trackSegment = track.GetTrackAtIndex(ti);
 
         // Add coin at 25% chance
-        if (25 > std::rand() % 100 + 0) {
+        if (25 > coinRandom.BelowAt(ti, 100)) {
             Coin newCoin(trackSegment.gamex, trackSegment.gamey - yDist, wCoin, hCoin);
             coins.push_back(newCoin);
         }
     }
+
+    coinCount = coins.size();
+    coinBounds.Assign(coins);
 }
 
-void ScoreCollectables::UpdateCoins(Player player, Uint64 ELAPSED_TIME) {
-    // this function moves the rect position of all coins stored in the vector
-    for (Coin &coin: coins) {
-        coin.UpdateRect(ELAPSED_TIME, player.GetPlayerSpeed()[0]);                                           // update all coins rect positions
-        coin.PlayerPickup(player, scoreBoard.score);                                                              // check for player within coin bounds
+void ScoreCollectables::StreamCoins(const Track& track, TileRange added) {
+    /*
+     * Used in endless mode when the track streams in the tiles of the added range. Coins behind the tiles still held
+     * by the track are retired, and coins are placed on the added tiles in the same way as ConstructCoins. The coins
+     * are held in a ring with a slot for every tile the track holds, so neither retiring nor adding coins moves the
+     * others, and the number of coins held stays bounded however far the player travels.
+     */
+    if (coinRing == 0) {
+        coins.clear();
+        coins.reserve(Track::CHUNK_TILES * Track::RING_CHUNKS);
+        coinRing = Track::CHUNK_TILES * Track::RING_CHUNKS;                                                             // at most one coin per tile
+        coinHead = coinCount = coinCursor = 0;
+    }
+
+    // retire coins no longer over the track, these are always at the front
+    double residentx = track.GetResidentRange().first * track.GetTrackWidthHeight().w;
+    size_t retired = 0;
+    while (coinCount > 0 && coins[coinHead].GetStruct()->gamex < residentx) {
+        coinHead = (coinHead + 1) % coinRing;
+        coinCount--;
+        retired++;
+    }
+    coinCursor -= std::min(coinCursor, retired);                                                                        // keep cursor on the same coin
+
+    int hCoin = track.GetTrackWidthHeight().h;                                                                          // Determine w h of coins
+    int wCoin = hCoin * 4/5;
+    int yDist = (track.GetTrackWidthHeight().h * 5/2) + (hCoin/2);
+    const RandomStream coinRandom = track.CreateRandomStream(RANDOM_COINS);
+
+    for (int ti = added.first; ti <= added.last; ti++) {
+        if (track.IsGapAtIndex(ti)) continue;
+        const TrackSegment &trackSegment = track.GetTrackAtIndex(ti);
+
+        // Add coin at 25% chance, in the slot after the last coin, which is only unused until the ring first fills
+        if (25 > coinRandom.BelowAt(ti, 100)) {
+            Coin newCoin(trackSegment.gamex, trackSegment.gamey - yDist, wCoin, hCoin);
+            size_t slot = (coinHead + coinCount) % coinRing;
+            if (slot == coins.size()) coins.push_back(newCoin);
+            else coins[slot] = newCoin;
+            coinCount++;
+        }
+    }
+
+    ItemRing<Coin> ring {coins, coinHead, coinCount, coinRing};
+    coinBounds.Assign(ring);                                                                                            // positions rebased to the first coin held
+}
+
+size_t ScoreCollectables::GetCoinCapacity() const {
+    return coins.capacity();
+}
+
+template <typename T>
+static void PickupItemsNearPlayer(const ItemRing<T> &items, AABBArrays &bounds, size_t &cursor,
+                                  const ObjectStruct& player, int &scoreBoard) {
+    /*
+     * Sort and sweep broadphase for item pickups. Items are sorted by gamex, and cursor is kept at the first item whose
+     * right edge is not behind the left edge of the player. The player mostly moves right, so the cursor only has to
+     * step forward a few items each tick (or back after a void out). The items overlapping the player horizontally are
+     * then tested 8 at a time by the overlap kernel, and only hits are passed to the item's PlayerPickup. Only the
+     * float arrays in bounds are read until there is a hit.
+     */
+    double minx = player.gamex - player.width/2.0, maxx = player.gamex + player.width/2.0;
+
+    cursor = std::min(cursor, bounds.count);
+    while (cursor > 0 && bounds.RightEdge(cursor - 1) >= minx) cursor--;                                                // player has moved back
+    while (cursor < bounds.count && bounds.RightEdge(cursor) < minx) cursor++;                                          // items now behind the player
+
+    for (size_t first = cursor; first < bounds.count && bounds.LeftEdge(first) <= maxx; first += AABBArrays::LANES) {
+        unsigned hits = OverlapMask(bounds, first, player);
+        for (int lane = 0; hits != 0; lane++, hits >>= 1) {
+            if ((hits & 1) == 0) continue;
+            if (items[first + lane].PlayerPickup(player, scoreBoard)) bounds.Disable(first + lane);                     // check for player within item bounds
+        }
     }
 }
 
+void ScoreCollectables::UpdateCoins(const ObjectStruct& player) {
+    // this function checks the coins around the player for being picked up
+    ItemRing<Coin> ring {coins, coinHead, coinCount, coinRing};
+    PickupItemsNearPlayer(ring, coinBounds, coinCursor, player, scoreBoard.score);
+}
+
 
 
 
-void ScoreCollectables::ConstructSpecials(Track track) {
+void ScoreCollectables::ConstructSpecials(const Track& track) {
     /*
      * This function will place a single collectable item within each third of the track. the collectable is given a 5%
      * chance to spawn on any given track, which repeatedly attempts generation until one succeeds. Upon success, the
      * generation region moves to the next third of the track.
      */
-    collectables = {};                                                                                                  // empty any previous collectables
-    int hColl = track.GetTrackWidthHeight()[1];                                                                         // Determine w h of collectables
-    int wColl = track.GetTrackWidthHeight()[0];
+    collectables.clear();                                                                                               // empty any previous collectables
+    collectables.reserve(3);
+    collectableCursor = 0;
+    int hColl = track.GetTrackWidthHeight().h;                                                                          // Determine w h of collectables
+    int wColl = track.GetTrackWidthHeight().w;
+    RandomStream specialRandom = track.CreateRandomStream(RANDOM_SPECIALS);
 
     // creates a collectible in each third of the track
-    int regionSize = (track.GetTrackStartEndIndex()[1] - track.GetTrackStartEndIndex()[0]) / 3;
-    int startIndex = track.GetTrackStartEndIndex()[0], endIndex = startIndex + regionSize;
+    int regionSize = (track.GetTrackStartEndIndex().last - track.GetTrackStartEndIndex().first) / 3;
+    int startIndex = track.GetTrackStartEndIndex().first, endIndex = startIndex + regionSize;
     int placed = 0;
     bool collectablePlaced = false;
 
     while (placed < 3) {
         for (int ti = startIndex; ti < endIndex; ti++) {
-            TrackSegment trackSegment = track.GetTrackAtIndex(ti);
-            if (trackSegment.trackIndex == track.GetTrackStartEndIndex()[0]) continue;
+            const TrackSegment &trackSegment = track.GetTrackAtIndex(ti);
+            if (trackSegment.trackIndex == track.GetTrackStartEndIndex().first) continue;
 
             // Add collectable at 5% chance
-            if (5 > std::rand() % 100 + 0) {
+            if (5 > specialRandom.Below(100)) {
                 // Determine distance from track top level that collectable sits at
-                int yDist = (track.GetTrackWidthHeight()[1]* 1/2) + (hColl / 2);
+                int yDist = (track.GetTrackWidthHeight().h* 1/2) + (hColl / 2);
 
                 if (track.IsObstacleAtIndex(trackSegment.trackIndex)) {
-                    yDist += track.GetTrackWidthHeight()[1];
+                    yDist += track.GetTrackWidthHeight().h;
                 }
                 Collectable newCollectable(trackSegment.gamex, trackSegment.gamey - yDist, wColl, hColl);
                 collectables.push_back(newCollectable);
@@ -132,15 +249,14 @@ void ScoreCollectables::ConstructSpecials(Track track) {
         }
 
     }
-}
 
-void ScoreCollectables::UpdateSpecials(Player player, Uint64 ELAPSED_TIME) {
-    // this function moves the rect position of all collectables stored in the vector
-    for (Collectable &collectable : collectables) {
-        collectable.UpdateRect(ELAPSED_TIME, player.GetPlayerSpeed()[0]);
+    collectableBounds.Assign(collectables);
+}
 
-        collectable.PlayerPickup(player, scoreBoard.score);
-    }
+void ScoreCollectables::UpdateSpecials(const ObjectStruct& player) {
+    // this function checks the collectables around the player for being picked up
+    ItemRing<Collectable> items {collectables, 0, collectables.size(), 0};
+    PickupItemsNearPlayer(items, collectableBounds, collectableCursor, player, scoreBoard.score);
 }
 
 
@@ -156,6 +272,19 @@ bool ScoreCollectables::CollectablesObtained() {
 
 
 
+void ScoreCollectables::TakeItems(ScoreCollectables& other) {
+    // used to move in a level generated elsewhere, the score is kept. The previous items are released here, rather
+    // than left in other
+    coins = std::move(other.coins);
+    collectables = std::move(other.collectables);
+    coinBounds = std::move(other.coinBounds);
+    collectableBounds = std::move(other.collectableBounds);
+    coinHead = other.coinHead;
+    coinCount = other.coinCount;
+    coinRing = other.coinRing;
+    coinCursor = collectableCursor = 0;
+}
+
 void ScoreCollectables::AddScore(int addScore) {
     scoreBoard.score  += addScore;
 }
@@ -165,93 +294,28 @@ int ScoreCollectables::GetScore() const {
 }
 
 
-void ScoreCollectables::CreateTextures(SDL_Renderer* RENDERER) {
+template <typename T>
+static void CaptureVisibleItems(const ItemRing<T> &items, std::vector<ObjectStruct> &view, double minx, double maxx) {
     /*
-     * Creates the textures for all coin and collectable objects. Additionally, creates the textures for the lives and
-     * score tracking labels.
+     * Copies the items still displayed with a game x position between minx and maxx into view. Items are constructed
+     * in order of their track index, so are sorted by gamex and the first of them can be found with a binary search.
      */
-    for (Coin &coin : coins) {
-        coin.CreateTexture(RENDERER);
+    view.clear();
+    size_t first = 0, last = items.size();
+    while (first < last) {
+        size_t middle = first + (last - first) / 2;
+        if (items[middle].GetStruct()->gamex + items[middle].GetStruct()->width/2.0 < minx) first = middle + 1;
+        else last = middle;
     }
 
-    for (Collectable &collectable : collectables) {
-        collectable.CreateTexture(RENDERER);
+    for (size_t i = first; i < items.size(); i++) {
+        if (items[i].GetStruct()->gamex - items[i].GetStruct()->width/2.0 > maxx) break;
+        if (items[i].CanDisplay()) view.push_back(*items[i].GetStruct());
     }
-
-    std::string fontPath = "../Resources/CookieCrisp/CookieCrisp-L36ly.ttf";
-    textFont = TTF_OpenFont(fontPath.c_str(), 200);
-
-    surface = TTF_RenderText_Blended(textFont, "Lives: ", textCol);
-    livesLabel = SDL_CreateTextureFromSurface(RENDERER, surface);
-    SDL_FreeSurface(surface);
-
-    surface = TTF_RenderText_Blended(textFont, "Score: ", textCol);
-    scoreLabel = SDL_CreateTextureFromSurface(RENDERER, surface);
-    SDL_FreeSurface(surface);
 }
 
-void ScoreCollectables::DisplayItems(SDL_Renderer *RENDERER, int xMin, int xMax) {
-    // Attempt to display all coin and collectable items where the rect position is within the window boundaries
-    for (Coin coin: coins) {
-        ObjectStruct *coinStruct = coin.GetStruct();
-        // only display if within the game screen
-        if (coinStruct->rectx <= xMax + coinStruct->width/2.0 && coinStruct->rectx >= xMin - coinStruct->width/2.0) {
-            coin.Display(RENDERER);
-        }
-    }
-
-    for (Collectable collectable : collectables) {
-        ObjectStruct *collStruct = collectable.GetStruct();
-        // only display if within the game screen
-        if (collStruct->rectx <= xMax + collStruct->width/2.0 && collStruct->rectx >= xMin - collStruct->width/2.0) {
-            collectable.Display(RENDERER);
-        }
-    }
+void ScoreCollectables::CaptureView(ItemsView& view, double minx, double maxx) {
+    // Copy the coin and collectable items that are between minx and maxx, for displaying
+    CaptureVisibleItems(ItemRing<Coin> {coins, coinHead, coinCount, coinRing}, view.coins, minx, maxx);
+    CaptureVisibleItems(ItemRing<Collectable> {collectables, 0, collectables.size(), 0}, view.collectables, minx, maxx);
 }
-
-void ScoreCollectables::DisplayScoreLives(SDL_Renderer* RENDERER, SDL_Window* WINDOW, Player player) {
-    /*
-     * This function displays the lives and score information in the top left of the window. The score texture is
-     * updated only when the score is updated. The lives are shown through taking the player texture as a lives icon,
-     * the number of this icon indicating the amount of lives left.
-     */
-
-    int GAME_WINDOW_HEIGHT, GAME_WINDOW_WIDTH;
-    SDL_GetWindowSize(WINDOW, &GAME_WINDOW_WIDTH, &GAME_WINDOW_HEIGHT);                                           // fetch window size
-
-    livesRect = {0, 0, GAME_WINDOW_WIDTH/12, GAME_WINDOW_HEIGHT/20};
-    SDL_RenderCopy(RENDERER, livesLabel, nullptr, &livesRect);
-
-    // DisplayTrack lives icons
-    for (int l = 0; l < player.GetLives(); l++) {
-        livesRect.x += livesRect.w + livesRect.w/20;
-        livesRect.w = livesRect.h;
-
-        SDL_RenderCopy(RENDERER, player.GetTexture(), nullptr, &livesRect);
-    }
-
-    // DisplayTrack score label
-    scoreRect = {0, GAME_WINDOW_HEIGHT / 20, GAME_WINDOW_WIDTH/12, GAME_WINDOW_HEIGHT/20};
-    SDL_RenderCopy(RENDERER, scoreLabel, nullptr, &scoreRect);
-
-    // Get score texture
-    if (scoreBoard.score != scoreBoard.prevScore) {
-        surface = TTF_RenderText_Blended(textFont, std::to_string(scoreBoard.score).c_str(), textCol);
-        scoreValue = SDL_CreateTextureFromSurface(RENDERER, surface);
-        SDL_FreeSurface(surface);
-
-        scoreBoard.prevScore = scoreBoard.score;
-    }
-
-    // align with score label:
-    int w, h;
-    double reqh = GAME_WINDOW_HEIGHT/20.0;
-    SDL_QueryTexture(scoreValue, nullptr, nullptr, &w, &h);
-    double ratio = h / reqh;                                                                                            // get scale factor to retain w:h ratio
-    h = int(h / ratio);                                                                                                 // apply scale factor to width height
-    w = int(w / ratio);
-
-    //Display Track score
-    scoreRect = {GAME_WINDOW_WIDTH/11, GAME_WINDOW_HEIGHT /20, w, h};
-    SDL_RenderCopy(RENDERER, scoreValue, nullptr, &scoreRect);
-}
\ No newline at end of file
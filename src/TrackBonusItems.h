@@ -7,6 +7,7 @@
 
 #include "GameCore.h"
 #include "Track.h"
+#include "Collision.h"
 
 class Track;
 
@@ -17,7 +18,7 @@ class Coin : public TrackObject {
 
     public:
         Coin(double x, double y, int w, int h);
-        bool PlayerPickup(Player &player, int &scoreBoard);
+        bool PlayerPickup(const ObjectStruct& player, int &scoreBoard);
 };
 
 
@@ -30,51 +31,67 @@ class Collectable : public TrackObject {
 
     public:
         Collectable(double x, double y, int w, int h);
-        bool PlayerPickup(Player &player, int &scoreBoard);
+        bool PlayerPickup(const ObjectStruct& player, int &scoreBoard);
         bool GetCollectedState() const;
 };
 
 
+// Copies of the coins and collectables still displayed around the camera, which is all that is needed to display them.
+// The vectors are reused, so capturing into the same view allocates nothing once they have grown to fit
+struct ItemsView {
+    std::vector<ObjectStruct> coins {};
+    std::vector<ObjectStruct> collectables {};
+};
+
+
+
 class ScoreCollectables {
     private:
-        // vectors to house Coins, ScoreCollectables
-        std::vector<Coin> coins {};
-        std::vector<Collectable> collectables {};
+        // vectors to house Coins, ScoreCollectables, allocated from the level's arena if it has one
+        ArenaVector<Coin> coins;
+        ArenaVector<Collectable> collectables;
+
+        // In endless mode the coins are held in a ring of coinRing slots, starting at coinHead, as coins are retired from
+        // the front whilst more are added to the back. coinRing is 0 when the coins are not a ring
+        size_t coinHead = 0, coinCount = 0;
+        size_t coinRing = 0;
+
+        // positions of the coins and collectables for collision, and broadphase cursors to the first that is not behind
+        // the player
+        AABBArrays coinBounds {};
+        AABBArrays collectableBounds {};
+        size_t coinCursor = 0;
+        size_t collectableCursor = 0;
 
         // score vars:
         struct {
-            int prevScore = 0;
             int score = 0;
         } scoreBoard;
 
-        // SDL and Display vars
-        SDL_Color textCol = {255, 255, 255};
-        TTF_Font* textFont {};
-        SDL_Surface* surface {};
-        SDL_Rect scoreRect {};
-        SDL_Rect livesRect {};
-        SDL_Texture* scoreLabel {};
-        SDL_Texture* scoreValue {};
-        SDL_Texture* livesLabel {};
-
     public:
+        ScoreCollectables() = default;
+        explicit ScoreCollectables(Arena* levelArena);
+
         // Coins
-        void ConstructCoins(Track track);
-        void UpdateCoins(Player player, Uint64 ELAPSED_TIME);
+        void ConstructCoins(const Track& track);
+        void StreamCoins(const Track& track, TileRange added);
+        void UpdateCoins(const ObjectStruct& player);
+        size_t GetCoinCapacity() const;
 
         // Collectables
-        void ConstructSpecials(Track track);
-        void UpdateSpecials(Player player, Uint64 ELAPSED_TIME);
+        void ConstructSpecials(const Track& track);
+        void UpdateSpecials(const ObjectStruct& player);
         bool CollectablesObtained();
 
+        // Replaces the coins and collectables with those constructed by other
+        void TakeItems(ScoreCollectables& other);
+
         // Scoreboard and Lives
         void AddScore(int addScore);
         int GetScore() const;
 
         // Display
-        void CreateTextures(SDL_Renderer* RENDERER);
-        void DisplayItems(SDL_Renderer* RENDERER, int xMin, int xMax);
-        void DisplayScoreLives(SDL_Renderer* RENDERER, SDL_Window* WINDOW, Player player);
+        void CaptureView(ItemsView& view, double minx, double maxx);
 };
 
 
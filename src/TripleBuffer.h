@@ -0,0 +1,48 @@
+//
+// Created by cew05 on 17/10/2026.
+//
+
+#ifndef CPP_PROGRAMMINGPROJECT_TRIPLEBUFFER_H
+#define CPP_PROGRAMMINGPROJECT_TRIPLEBUFFER_H
+
+#include <array>
+#include <atomic>
+
+/*
+ * Passes the latest value from one writing thread to one reading thread without locking. The writer fills the back
+ * slot and publishes it, swapping it with the middle slot, and the reader swaps the middle slot with the front slot
+ * when it holds a newer value. Neither thread waits for the other, the reader just skips any values published in
+ * between, and a slot is never read and written at the same time.
+ */
+template <typename T>
+class TripleBuffer {
+    private:
+        static const int SLOT_MASK = 3;
+        static const int FRESH = 4;                                                                                     // middle slot was published since the last Acquire
+
+        std::array<T, 3> slots {};
+        std::atomic<int> middle {1};
+        int back = 0;                                                                                                   // owned by the writer
+        int front = 2;                                                                                                  // owned by the reader
+
+    public:
+        // Writer
+        T& Back() {
+            return slots[back];
+        }
+        void Publish() {
+            back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & SLOT_MASK;
+        }
+
+        // Reader, returns true if Front changed
+        bool Acquire() {
+            if ((middle.load(std::memory_order_relaxed) & FRESH) == 0) return false;
+            front = middle.exchange(front, std::memory_order_acq_rel) & SLOT_MASK;
+            return true;
+        }
+        const T& Front() const {
+            return slots[front];
+        }
+};
+
+#endif //CPP_PROGRAMMINGPROJECT_TRIPLEBUFFER_H
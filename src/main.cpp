@@ -2,196 +2,199 @@
 // Created by cew05 on 20/02/2024.
 //
 #include "GameCore.h"
-#include "Track.h"
-#include "Player.h"
-#include "TrackBonusItems.h"
-
-HighScore GameLoop(std::string &viewScreen, SDL_Window* WINDOW, SDL_Renderer* RENDERER) {
+#include "GameSession.h"
+#include "AssetCache.h"
+#include "Benchmarks.h"
+#include "Replay.h"
+#include "Profiler.h"
+#include "TextRenderer.h"
+#include "Log.h"
+#include "Renderer.h"
+#include "SimulationThread.h"
+#include "FramePacer.h"
+#include "GameDisplay.h"
+
+HighScore GameLoop(std::string &viewScreen, SDL_Window* WINDOW, Renderer& renderer, AssetCache& assets,
+                   FramePacer& pacer, ReplayReader* replay = nullptr) {
     /*
-     * The GameLoop function is where the programs actual gameloop is held. Within this function, the program will
-     * repeat the game object update cycle until the player either presses the close button or runs out of lives
-     * causing a game-over. The loop returns a HighScore struct to be tested against the prior High Scores.
+     * The GameLoop function is the SDL front end for a GameSession. Within this function, the program will poll for
+     * input, step the session and display the game objects until the player either presses the close button or runs
+     * out of lives causing a game-over. The loop returns a HighScore struct to be tested against the prior High Scores.
+     *
+     * The session is stepped on a SimulationThread in fixed SIM_TICK steps, so gameplay is the same at any frame rate
+     * and a slow frame or present does not delay the simulation. This thread samples the inputs and displays the
+     * latest snapshot of the session, interpolated by the wall time that has not yet been simulated.
+     *
+     * Frames are paced to the pacer's active rate, or its idle rate whilst the game is paused. The frame times are
+     * logged when the loop ends.
+     *
+     * viewScreen "endless" plays the same loop in endless mode, where the track is streamed in rather than split into
+     * levels.
+     *
+     * The inputs of every step are recorded to RequiredFiles/Replay_<seed>.rpl. If a replay is given, its inputs are
+     * played back instead of the keyboard's, and the loop ends with the recording.
+     *
+     * When built with ENABLE_PROFILER, each phase of the frame is timed, and F3 toggles an overlay of the timings.
      */
 
     HighScore newScore;                                                                                                 // Create new score to save game results into
     newScore.SetValues({"void", "void", "void"});                                                              // Provide rubbish data so program knows an invalid score is returned
-    if (viewScreen != "game") return newScore;                                                                          // not game view so dont load the gameloop
+    if (viewScreen != "game" && viewScreen != "endless") return newScore;                                               // not game view so dont load the gameloop
+    const std::string gameView = viewScreen;
 
-    //  CONSTRUCT THE "GLOBAL" VARS THAT MANAGE THE GAME
     int GAME_WINDOW_HEIGHT, GAME_WINDOW_WIDTH;
     SDL_GetWindowSize(WINDOW, &GAME_WINDOW_WIDTH, &GAME_WINDOW_HEIGHT);                                           // fetch window size
 
-    int TILE_WIDTH = 48;                                                                                                // set w h of game tile
-    int TILE_HEIGHT = 48;
-
-    int MIN_TRACK_HEIGHT = GAME_WINDOW_HEIGHT - int(2.5 * TILE_HEIGHT);                                                 // set min and max height of track generation
-    int MAX_TRACK_HEIGHT = MIN_TRACK_HEIGHT - (10 * TILE_HEIGHT);
-
-    int DIFFICULTY = 0;                                                                                                 // Set difficulty of the game to base level 0
-    int JUMPHEIGHT = 6*TILE_HEIGHT;
-    double GRAVITY = JUMPHEIGHT / (2*std::pow(1500/4.0, 2));
-
-    const unsigned int RANDOM_SEED = time(nullptr);                                                                // seed the random calculations randomly
-    //const unsigned int RANDOM_SEED = 1712404869;                                                                      // seed the random calculations predictably
-    std::srand(RANDOM_SEED);
+    unsigned int RANDOM_SEED = time(nullptr);                                                                           // seed the random calculations randomly
+    //unsigned int RANDOM_SEED = 1712404869;                                                                            // seed the random calculations predictably
+    if (replay) {                                                                                                       // play back with the recorded seed and window size
+        RANDOM_SEED = replay->GetHeader().seed;
+        GAME_WINDOW_WIDTH = replay->GetHeader().windowWidth;
+        GAME_WINDOW_HEIGHT = replay->GetHeader().windowHeight;
+    }
     printf("Using SEED: %u\n", RANDOM_SEED);
 
-    // ConstructRect track, player and ScoreCollectables class
-    Player player {TILE_WIDTH, TILE_HEIGHT, MIN_TRACK_HEIGHT};
-    Track track {MIN_TRACK_HEIGHT, MAX_TRACK_HEIGHT, TILE_WIDTH, TILE_HEIGHT};
-    ScoreCollectables collectables{};
-
-    // Set player states:
-    player.SetPlayerSpeed((TILE_WIDTH/240.0) * (1 + DIFFICULTY*0.1));                                      // takes 240 gameticks to cross 1 tile, increases with difficulty
-    player.SetPlayerJumpCalcVars(JUMPHEIGHT, GRAVITY);
-
-    // Set track states:
-    track.SetPlayerJumpCalcVars(JUMPHEIGHT, GRAVITY, player.GetPlayerSpeed()[0]);
-
-    // CREATE FIRST LEVEL TRACK
-    // Create track
-    track.ConstructTrack(DIFFICULTY);
+    // Record the inputs, so that the run can be reproduced
+    ReplayWriter recorder;
+    if (!replay) {
+        std::string replayPath = "../RequiredFiles/Replay_" + std::to_string(RANDOM_SEED) + ".rpl";
+        std::string error;
+        ReplayHeader header {RANDOM_SEED, GAME_WINDOW_WIDTH, GAME_WINDOW_HEIGHT, gameView == "endless"};
+        if (recorder.Open(replayPath, header, error)) {
+            printf("RECORDING REPLAY | %s\n", replayPath.c_str());
+        } else {
+            printf("RECORDING REPLAY | ERROR: %s\n", error.c_str());
+        }
+    }
 
-    // Create collectibles
-    collectables.ConstructCoins(track);
-    collectables.ConstructSpecials(track);
+    // Construct the session, which holds the player, track and collectables
+    GameSession session {GAME_WINDOW_WIDTH, GAME_WINDOW_HEIGHT, RANDOM_SEED, true, gameView == "endless"};
 
-    // Create Textures
-    player.CreateTexture(RENDERER);
-    track.CreateTextures(RENDERER);
-    collectables.CreateTextures(RENDERER);
+    // Create the textures the game is displayed with, these are held here on the render thread for every level
+    TrackDisplay trackDisplay;
+    ItemsDisplay itemsDisplay;
+    PlayerDisplay playerDisplay;
+    trackDisplay.CreateTextures(assets);
+    itemsDisplay.CreateTextures(assets);
+    playerDisplay.CreateTexture(assets);
+    int displayedLevel = session.GetLevelsConstructed();                                                                // level last displayed, to report transitions
 
-    // end of level adding score/lives management
-    bool endOfTrackScoreAdded = false;
-    bool endOfTrackLivesAdded = false;
+    const double counterPerMs = double(SDL_GetPerformanceFrequency()) / 1000.0;
 
-    // set deltaTicks vars
-    Uint64 prevtick = SDL_GetTicks64();
-    Uint64 tickchange = 0;                                                                                              // for retaining tick change since SDL_GetTicks64() last called
-    Uint64 scoreTick = 0;                                                                                               // for determining when player recieves score over time
-    Uint64 ELAPSED_TIME = 0;                                                                                            // Set elapsed time of the game to 0
+#ifdef ENABLE_PROFILER
+    AtlasHandle overlayAtlas = assets.GetGlyphAtlas("../Resources/CookieCrisp/CookieCrisp-L36ly.ttf", 200);
+#endif
 
-    // game pausing control
-    bool paused = false;
+    // Step the session on its own thread from here, until the game is over or the loop is left
+    SimulationThread simulation {session, recorder, replay};
+    simulation.Start();
+    pacer.SetIdle(false);
+    pacer.ResetStats();
 
-    while (viewScreen == "game" && player.GetLives() > -1) {
-        // update deltaTick vars
-        ELAPSED_TIME += tickchange;
-        scoreTick += tickchange;                                                                                        // tickchange prevented from increasing whilst game paused
-        tickchange = (paused) ? 0 : SDL_GetTicks64() - prevtick;                                                        // which prevents player position from changing
-        prevtick = SDL_GetTicks64();                                                                                    // and track/collectable rect positions from changing
+    while (viewScreen == gameView) {
+        PROFILE_END_FRAME();                                                                                            // timings of the previous frame
+        PROFILE_SCOPE(PROFILE_FRAME);
+        Uint64 counter = SDL_GetPerformanceCounter();
 
         // check for close event
-        SDL_Event event;
-        while (SDL_PollEvent(&event)) {
-            switch (event.type) {
-                case SDL_QUIT:
-                    viewScreen = "end";                                                                                 // breaks while loop for gameloop
-                    break;
-
-                default:
-                    break;
+        SessionInputs inputs;
+        {
+            PROFILE_SCOPE(PROFILE_EVENTS);
+            SDL_Event event;
+            while (SDL_PollEvent(&event)) {
+                switch (event.type) {
+                    case SDL_QUIT:
+                        viewScreen = "end";                                                                             // breaks while loop for gameloop
+                        break;
+
+                    case SDL_KEYDOWN:
+                        if (event.key.keysym.scancode == SDL_SCANCODE_F3 && !event.key.repeat) PROFILE_TOGGLE_OVERLAY();
+                        break;
+
+                    default:
+                        break;
+                }
             }
-        }
 
-        // check keyinput events
-        const std::uint8_t *keystates = SDL_GetKeyboardState(nullptr);
-        if (keystates[SDL_SCANCODE_P]) paused = true;                                                                   // pause the game
-        if (keystates[SDL_SCANCODE_R]) paused = false;                                                                  // unpause the game
-        if (keystates[SDL_SCANCODE_SPACE]) player.Jump(true);                                                  // player jump management
-        if (!keystates[SDL_SCANCODE_SPACE]) player.Jump(false);                                                // player jump management (player not holding jump key)
-
-        // MAIN GAMEPLAY HANDLING
-        if (!player.AtEndOfTrack(track)) {
-            // update player
-            player.MovementUpdate(track, tickchange, ELAPSED_TIME);
-            player.CheckVoidOut(GAME_WINDOW_HEIGHT, ELAPSED_TIME);
-
-            // Update track
-            track.UpdateTrackRects(ELAPSED_TIME);
-
-            // Update collectables
-            collectables.UpdateCoins(player, ELAPSED_TIME);
-            collectables.UpdateSpecials(player, ELAPSED_TIME);
-
-            // Check for obstacle collision:
-            if (track.CheckForCollision(player)) {
-                player.ForceVoidOut();
-            }
-
-            // apply score over time
-            if (scoreTick >= 50) {
-                collectables.AddScore(5);
-                scoreTick = (scoreTick > 50) ? scoreTick - 50 : 0;
-            }
+            // check keyinput events, applied to every step until the next frame
+            const std::uint8_t *keystates = SDL_GetKeyboardState(nullptr);
+            inputs.pausePressed = keystates[SDL_SCANCODE_P];                                                            // pause the game
+            inputs.resumePressed = keystates[SDL_SCANCODE_R];                                                           // unpause the game
+            inputs.jumpHeld = keystates[SDL_SCANCODE_SPACE];                                                            // player jump management
+            simulation.SetInputs(inputs);
         }
 
-        // END OF LEVEL HANDLING : ENDING MOVEMENT + SCORE + LIVES
-        if (player.OnScreen(0, GAME_WINDOW_WIDTH) && player.AtEndOfTrack(track)) {
-            // End of level handling:
-            track.UpdateTrackRects(ELAPSED_TIME);
-
-            // Award score for completing level
-            if (!endOfTrackScoreAdded) {
-                collectables.AddScore(3000);
-                endOfTrackScoreAdded = true;
-            }
-
-            // Check if player has collected all 3 collectables
-            if (collectables.CollectablesObtained() && !endOfTrackLivesAdded) {
-                player.AddPlayerLives(1);
-                endOfTrackLivesAdded = true;
-            }
+        // DISPLAY HANDLING
+        // everything is displayed from the snapshot, so the session is stepped on the simulation thread meanwhile
+        const FrameSnapshot& snapshot = simulation.GetSnapshot();
+        if (snapshot.finished) break;                                                                                   // game over, or the end of the recording
+
+        RenderState renderState = snapshot.Interpolate(SDL_GetPerformanceCounter());
+        Camera camera {renderState.cameraX, GAME_WINDOW_WIDTH, GAME_WINDOW_HEIGHT};
+        bool levelTransition = snapshot.levelsConstructed != displayedLevel;                                            // first frame of a new level
+        displayedLevel = snapshot.levelsConstructed;
+
+        {
+            PROFILE_SCOPE(PROFILE_BACKGROUND);
+            trackDisplay.DisplayBackground(renderer, GAME_WINDOW_WIDTH, GAME_WINDOW_HEIGHT);
+        }
+        {
+            PROFILE_SCOPE(PROFILE_DISPLAY_TRACK);
+            trackDisplay.DisplayTrack(renderer, snapshot.track, camera);
+        }
+        {
+            PROFILE_SCOPE(PROFILE_DISPLAY_PLAYER);
+            playerDisplay.Display(renderer, renderState.playerx, renderState.playery, snapshot.playerSize);
+        }
+        {
+            PROFILE_SCOPE(PROFILE_DISPLAY_ITEMS);
+            itemsDisplay.DisplayItems(renderer, snapshot.items, camera);
         }
 
-        // END OF LEVEL HANDLING : NEW LEVEL GENERATION
-        if (!player.OnScreen(0, GAME_WINDOW_WIDTH)) {
-            // Increase Difficulty (max 6)
-            DIFFICULTY = (DIFFICULTY < 6) ? DIFFICULTY + 1 : 6;
-
-            // Reset player position, increase speed
-            player.ResetPlayerPosition(MIN_TRACK_HEIGHT);
-            player.SetPlayerSpeed((TILE_WIDTH/240.0) * (1 + DIFFICULTY*0.1));
-
-            // Reset track, set new jump calc vars (for changed playerspeed)
-            track.SetPlayerJumpCalcVars(JUMPHEIGHT, GRAVITY, player.GetPlayerSpeed()[0]);
-            track.ConstructTrack(DIFFICULTY);
-            track.CreateTextures(RENDERER);
-
-            // Reset collectables
-            collectables.ConstructCoins(track);
-            collectables.ConstructSpecials(track);
-            collectables.CreateTextures(RENDERER);
-
-            endOfTrackScoreAdded = false;
-            endOfTrackLivesAdded = false;
-
-            // Reset elapsed time
-            ELAPSED_TIME = 0;
+        // report the time taken to display the new level, which includes composing its terrain pages
+        if (levelTransition) {
+            LOG_INFO("LEVEL TRANSITION | DIFFICULTY: %d, display: %.3f ms", snapshot.difficulty,
+                     double(SDL_GetPerformanceCounter() - counter) / counterPerMs);
+            assets.PrintStats();
         }
 
-        // DISPLAY HANDLING
-        track.DisplayBackground(RENDERER, WINDOW);
-        track.DisplayTrack(RENDERER, WINDOW);
+        {
+            PROFILE_SCOPE(PROFILE_DISPLAY_HUD);
+            itemsDisplay.DisplayScoreLives(renderer, GAME_WINDOW_WIDTH, GAME_WINDOW_HEIGHT, snapshot.score,
+                                           snapshot.lives, playerDisplay.GetTexture());
+            PROFILE_DRAW_OVERLAY(renderer, *overlayAtlas, 10, GAME_WINDOW_HEIGHT / 8, GAME_WINDOW_HEIGHT / 50);
+        }
+        {
+            PROFILE_SCOPE(PROFILE_PRESENT);
+            renderer.Present();
+            renderer.Clear({0, 0, 0, 255});
+        }
 
-        player.Display(track, ELAPSED_TIME, RENDERER);
+        // wait for the next frame, at a low rate whilst nothing moves
+        pacer.SetIdle(snapshot.paused);
+        pacer.Wait();
+    }
 
-        collectables.DisplayItems(RENDERER, 0, GAME_WINDOW_WIDTH);
-        collectables.DisplayScoreLives(RENDERER, WINDOW, player);
+    simulation.Stop();
+    Uint64 tick = simulation.GetTick();
 
-        SDL_RenderPresent(RENDERER);
-        SDL_RenderClear(RENDERER);
-    }
+    FramePacerStats pacing = pacer.GetStats();
+    LOG_INFO("FRAME PACING | target: %.3f ms, mean: %.3f ms, jitter: %.3f ms, max: %.3f ms, sleep: %.3f ms, "
+             "spin: %.3f ms (last %llu frames)", pacing.targetMs, pacing.meanMs, pacing.jitterMs, pacing.maxMs,
+             pacing.sleepMs, pacing.spinMs, (unsigned long long)pacing.frames);
 
     // HANDLE END OF GAME
     if (viewScreen != "end") viewScreen = "menu";                                                                       // viewScreen "end" is a request to close the program fully
+    int score = session.GetCollectables().GetScore();                                                                   // the session is no longer stepped
+    recorder.Finish(tick, score);
+    if (replay) return newScore;                                                                                        // replayed scores are not saved
 
     // Get date:
     char timeString[sizeof("yyyy-mm-ddThh:mm:ssZ")];
     time_t t = time(nullptr);                                                                                     // Gets the current time
     std::strftime(timeString, sizeof(timeString), "%d/%m/%Y", localtime(&t));
     newScore.SetValues({timeString,
-                        std::to_string(collectables.GetScore()),
+                        std::to_string(score),
                         std::to_string(RANDOM_SEED)}
                         );
 
@@ -201,13 +204,70 @@ HighScore GameLoop(std::string &viewScreen, SDL_Window* WINDOW, SDL_Renderer* RE
 
 
 
-void MenuLoop(std::string &viewScreen, Menu menu, SDL_Renderer* RENDERER) {
+int HeadlessLoop(Uint64 totalTicks, unsigned int seed, bool endless) {
+    /*
+     * Runs GameSessions without a window or renderer for the given number of game ticks, stepping 1 SIM_TICK at a time
+     * as fast as possible. A simple bot holds the jump key on a fixed cycle. When a session ends in a game-over, a new one
+     * is started with the next seed. The achieved tick rate is printed once complete. Sessions are played in endless
+     * mode if endless is set.
+     */
+    int GAME_WINDOW_WIDTH = 1386, GAME_WINDOW_HEIGHT = 1078;                                                            // typical windowed size on a 1080p display
+
+    auto startTime = std::chrono::steady_clock::now();
+    int sessions = 1;
+    int levels = 0;
+
+    std::unique_ptr<GameSession> session (new GameSession {GAME_WINDOW_WIDTH, GAME_WINDOW_HEIGHT, seed, true, endless});
+    for (Uint64 tick = 0; tick < totalTicks; tick += GameSession::SIM_TICK) {
+        if (session->GameOver()) {
+            session.reset();                                                                                            // finish the old session (and its level generation) first
+            session.reset(new GameSession {GAME_WINDOW_WIDTH, GAME_WINDOW_HEIGHT, ++seed, true, endless});
+            sessions++;
+        }
+
+        SessionInputs inputs;
+        inputs.jumpHeld = (tick % 900) < 350;                                                                           // hold jump for 350 of every 900 ticks
+
+        session->Step(inputs);
+        if (session->ConsumeLevelChanged()) levels++;
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    Logger::Get().Flush();                                                                                              // keep the session's log above the result
+    printf("HEADLESS | ticks: %llu, sessions: %d, levels: %d, time: %.3fs, ticks/s: %.0f\n",
+           (unsigned long long)totalTicks, sessions, levels, seconds, double(totalTicks) / seconds);
+
+    return 0;
+}
+
+
+
+int ReplayLoop(ReplayReader& replay) {
+    // Plays a replay without a window as fast as possible, reporting whether the session followed the recording
+    const ReplayHeader& header = replay.GetHeader();
+    printf("REPLAY | seed: %u, window: %dx%d%s\n", header.seed, header.windowWidth, header.windowHeight,
+           header.endless ? ", endless" : "");
+
+    ReplayResult result = PlayReplayHeadless(replay);
+    Logger::Get().Flush();
+    printf("REPLAY | ticks: %llu, score: %d, time: %.3fs, speed: %.0fx real time | %s%s\n",
+           (unsigned long long)result.ticks, result.score, result.seconds,
+           double(result.ticks * GameSession::SIM_TICK) / 1000.0 / std::max(result.seconds, 1e-9),
+           result.desynced ? "DESYNC: " : "MATCH", result.reason.c_str());
+
+    return result.desynced ? 1 : 0;
+}
+
+
+
+void MenuLoop(std::string &viewScreen, Menu menu, Renderer& renderer, FramePacer& pacer) {
     /*
      * This is the MenuLoop, where the user is held whilst the start screen should be showing. THe program will remain
      * within this loop until the user either presses the start game button, or the user closes the window.
-     * The loop will otherwise continue to display the start screen information.
+     * The loop will otherwise continue to display the start screen information, at the pacer's idle rate.
      */
     if (viewScreen != "menu") return;
+    pacer.SetIdle(true);
 
     while (viewScreen == "menu") {
         // check for close event
@@ -223,26 +283,89 @@ void MenuLoop(std::string &viewScreen, Menu menu, SDL_Renderer* RENDERER) {
         // check keyinput events
         const std::uint8_t *keystates = SDL_GetKeyboardState(nullptr);
         if (keystates[SDL_SCANCODE_SPACE]) viewScreen = "game";
+        if (keystates[SDL_SCANCODE_E]) viewScreen = "endless";
 
-        menu.Display(RENDERER);
+        menu.Display(renderer);
 
         // Update screen display
-        SDL_RenderPresent(RENDERER);
-        SDL_RenderClear(RENDERER);
+        renderer.Present();
+        renderer.Clear({0, 0, 0, 255});
+        pacer.Wait();
     }
 }
 
 
 
 
-int main()
+int main(int argc, char* argv[])
 /*
  * Initialise SDL and SDL_ttf, create a window for the program and set it to the correct dimensions. Within main, the
  * program constructs a loop based upon the contents of var viewScreen. The loop will only end once the user closes
  * the SDL window, causing viewScreen to be set to "end". SDL and SDL_ttf are uninitialised and the program ended.
+ *
+ * Passing "--headless [ticks] [seed] [--endless]" instead runs the simulation without initialising SDL or opening a window, and
+ * "--bench <name>" runs one of the benchmarks in Benchmarks.cpp. "--replay <file>" plays a recorded run without a
+ * window, or in the window with "--replay <file> --watch".
+ *
+ * Any of these can be preceded by "--trace <file>", which records a Chrome trace of the run to file on exit, and by
+ * options for the window: "--vsync" waits for the display's refresh when presenting, "--fps <rate>" sets the frame
+ * rate of the game (0 for unlimited, the display's refresh rate by default, unless vsync is on) and "--idle-fps <rate>"
+ * sets the frame rate of the menu and paused game (30 by default).
  */
 
 {
+    struct TraceOutput {                                                                                                // writes the trace on any return from main
+        std::string path;
+        ~TraceOutput() {
+            if (!path.empty()) TRACE_WRITE(path);
+        }
+    } traceOutput;
+
+    double gameFrameRate = -1, idleFrameRate = 30;                                                                      // -1 for the display's refresh rate
+    bool vsync = false;
+    while (argc > 1) {                                                                                                  // remaining options are read as normal
+        std::string option = argv[1];
+        if (option == "--trace" && argc > 2) {
+            traceOutput.path = argv[2];
+            TRACE_START();
+            TRACE_THREAD_NAME("game");
+        }
+        else if (option == "--fps" && argc > 2) gameFrameRate = std::stod(argv[2]);
+        else if (option == "--idle-fps" && argc > 2) idleFrameRate = std::stod(argv[2]);
+        else if (option == "--vsync") vsync = true;
+        else break;
+
+        int used = (option == "--vsync") ? 1 : 2;
+        argc -= used;
+        argv += used;
+    }
+
+    GenerationProfiles::Get();                                                                                          // load track generation profiles, reporting any errors
+
+    if (argc > 1 && std::string(argv[1]) == "--headless") {
+        Uint64 ticks = (argc > 2) ? std::stoull(argv[2]) : 1000000;
+        unsigned int seed = (argc > 3) ? unsigned(std::stoul(argv[3])) : unsigned(time(nullptr));
+        bool endless = (argc > 4) && std::string(argv[4]) == "--endless";
+        return HeadlessLoop(ticks, seed, endless);
+    }
+
+    if (argc > 2 && std::string(argv[1]) == "--bench") {
+        return RunBenchmark(argv[2]);
+    }
+
+    std::unique_ptr<ReplayReader> watchReplay {};                                                                       // replay to show in the window
+    if (argc > 2 && std::string(argv[1]) == "--replay") {
+        std::unique_ptr<ReplayReader> replay (new ReplayReader);
+        std::string error;
+        if (!replay->Open(argv[2], error)) {
+            printf("REPLAY | ERROR: %s\n", error.c_str());
+            return 1;
+        }
+
+        if (argc < 4 || std::string(argv[3]) != "--watch") return ReplayLoop(*replay);
+        watchReplay = std::move(replay);
+    }
+
     if (SDL_Init(SDL_INIT_EVERYTHING) != 0){                                                                       // Initialise SDL
         printf("Error initialising SDL: %s", SDL_GetError());
         return 0;
@@ -273,22 +396,51 @@ int main()
 
     SDL_SetWindowSize(WINDOW, winRect.w, winRect.h);                                                                    // set window size
     SDL_SetWindowPosition(WINDOW, SDL_WINDOWPOS_CENTERED, winRect.y);                                                // set window to centre of screen
-    printf("WINDOW SIZE | w: %d, h: %d", winRect.w, winRect.h);
+    printf("WINDOW SIZE | w: %d, h: %d\n", winRect.w, winRect.h);
 
-    SDL_Renderer* RENDERER = SDL_CreateRenderer(WINDOW, -1, SDL_RENDERER_ACCELERATED);                       // Create renderer to render images to SDL window
+    Uint32 rendererFlags = SDL_RENDERER_ACCELERATED | (vsync ? SDL_RENDERER_PRESENTVSYNC : 0);
+    SDL_Renderer* RENDERER = SDL_CreateRenderer(WINDOW, -1, rendererFlags);                                             // Create renderer to render images to SDL window
 
-    Menu menu(winRect.w, winRect.h);                                                                                    // Construct start screen menu
-    menu.ObtainScoreInfo();                                                                                             // Fetch high score info stored in "GenerationPercs.txt"
-    menu.CreateTextures(RENDERER);
+    // Pace the game to the display's refresh rate, unless presenting already waits for it
+    if (gameFrameRate < 0) {
+        SDL_DisplayMode displayMode {};
+        int display = SDL_GetWindowDisplayIndex(WINDOW);
+        bool knownRate = SDL_GetCurrentDisplayMode(display, &displayMode) == 0 && displayMode.refresh_rate > 0;
+        gameFrameRate = vsync ? 0 : (knownRate ? displayMode.refresh_rate : 60);
+    }
+    FramePacer pacer(gameFrameRate, idleFrameRate);
+    printf("FRAME PACING | game: %.0f fps, idle: %.0f fps, vsync: %s\n", gameFrameRate, idleFrameRate,
+           vsync ? "on" : "off");
+
+    {
+        AssetCache assets(RENDERER);                                                                                    // Shared textures and fonts, loaded once
+        SDLRenderer renderer(RENDERER);                                                                                 // game objects draw through this
+
+        Menu menu(winRect.w, winRect.h);                                                                                // Construct start screen menu
+        menu.ObtainScoreInfo();                                                                                         // Fetch high score info stored in "GenerationPercs.txt"
+        menu.CreateTextures(assets);
+
+        std::string viewScreen = "menu";
+        if (watchReplay) {                                                                                              // show the replay, then close
+            viewScreen = watchReplay->GetHeader().endless ? "endless" : "game";
+            GameLoop(viewScreen, WINDOW, renderer, assets, pacer, watchReplay.get());
+            viewScreen = "end";
+        }
+
+        while (viewScreen != "end"){                                                                                    // The program loop ends when user hits the close button
+            MenuLoop(viewScreen, menu, renderer, pacer);                                                                // loads either the game or menu,
+            HighScore newScore = GameLoop(viewScreen, WINDOW, renderer, assets, pacer);                                 // depending on what viewScreen is set to
+            menu.SaveScore(newScore);
+            menu.CreateTextures(assets);
+        }
 
-    std::string viewScreen = "menu";
-    while (viewScreen != "end"){                                                                                        // The program loop ends when user hits the close button
-        MenuLoop(viewScreen, menu, RENDERER);                                                                        // loads either the game or menu,
-        HighScore newScore = GameLoop(viewScreen, WINDOW, RENDERER);                                                 // depending on what viewScreen is set to
-        menu.SaveScore(newScore);
-        menu.CreateTextures(RENDERER);
+        assets.PrintStats();
+        PROFILE_WRITE_CSV("../RequiredFiles/Profile.csv");                                                              // timings of every frame played
+        assets.Clear();                                                                                                 // Release cached assets, menu handles released at end of scope
     }
 
+    SDL_DestroyRenderer(RENDERER);
+    SDL_DestroyWindow(WINDOW);
     TTF_Quit();                                                                                                         // Deinitialise libraries for safe program exit
     SDL_Quit();
 